@@ -42,7 +42,6 @@ UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 #include "GmAppConfig.h"
 #include "GmAppConfigWidget.h"
 #include "GmCommon.h"
-#include "GridNode.h"
 #include "IntensityMeasureWidget.h"
 #include "Utils/ProgramOutputDialog.h"
 #include "MapViewSubWidget.h"
@@ -86,6 +85,7 @@ UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 // GIS includes
 #include "SimCenterMapcanvasWidget.h"
 #include "QGISVisualizationWidget.h"
+#include "ScreenToGeoTransform.h"
 #include "MapViewWindow.h"
 #include <qgsmapcanvas.h>
 #include <qgsvectorlayer.h>
@@ -100,10 +100,17 @@ GMWidget::GMWidget(VisualizationWidget* visWidget, QWidget *parent) : SimCenterA
 
     simulationComplete = false;
 
-    process = new QProcess(this);
-    connect(process, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished), this, &GMWidget::handleProcessFinished);
-    connect(process, &QProcess::readyReadStandardOutput, this, &GMWidget::handleProcessTextOutput);
-    connect(process, &QProcess::started, this, &GMWidget::handleProcessStarted);
+    // The hazard simulation runs in the background, its output is streamed to the status window
+    hazardRunner = new ProcessRunner(this);
+    connect(hazardRunner, &ProcessRunner::finished, this, &GMWidget::handleProcessFinished);
+    connect(hazardRunner, &ProcessRunner::outputLine, this, &GMWidget::handleProcessTextOutput);
+    connect(hazardRunner, &ProcessRunner::errorLine, this, &GMWidget::handleProcessTextOutput);
+    connect(hazardRunner, &ProcessRunner::progress, this, &GMWidget::handleProcessProgress);
+    connect(hazardRunner, &ProcessRunner::failedToStart, this, [this](const QString& err){
+        this->errorMessage("Could not start the hazard simulation: " + err);
+        this->getProgressDialog()->hideProgressBar();
+    });
+    connect(hazardRunner, &ProcessRunner::started, this, &GMWidget::handleProcessStarted);
 
 
     // Adding Site Config Widget
@@ -124,6 +131,10 @@ GMWidget::GMWidget(VisualizationWidget* visWidget, QWidget *parent) : SimCenterA
     this->m_selectionWidget = new RecordSelectionWidget(*this->m_selectionconfig);
 
     m_runButton = new QPushButton(tr("&Run Hazard Simulation"));
+
+    m_cancelButton = new QPushButton(tr("&Cancel"));
+    m_cancelButton->setEnabled(false);
+    connect(m_cancelButton, &QPushButton::clicked, this, &GMWidget::cancelHazardSimulation);
     //m_settingButton = new QPushButton(tr("&Path Settings"));
 
     // Adding vs30 widget
@@ -133,6 +144,7 @@ GMWidget::GMWidget(VisualizationWidget* visWidget, QWidget *parent) : SimCenterA
     auto buttonsLayout = new QHBoxLayout();
     //buttonsLayout->addWidget(this->m_settingButton);
     buttonsLayout->addWidget(this->m_runButton);
+    buttonsLayout->addWidget(this->m_cancelButton);
 
 
     /*
@@ -622,6 +634,12 @@ bool GMWidget::inputFromJSON(QJsonObject &/*jsonObject*/){
 
 void GMWidget::runHazardSimulation(void)
 {
+    // Checked before anything is written, the input files of the running simulation must not be overwritten
+    if(hazardRunner->isRunning())
+    {
+        this->errorMessage("A hazard simulation is already running, wait for it to finish or cancel it first");
+        return;
+    }
 
     simulationComplete = false;
 
@@ -823,7 +841,7 @@ void GMWidget::runHazardSimulation(void)
             return;
         }
 
-        // Get the vector of grid nodes
+        // Get the grid node locations
 
         if(userGrid == nullptr)
         {
@@ -832,23 +850,28 @@ void GMWidget::runHazardSimulation(void)
             return;
         }
 
-        auto gridNodeVec = userGrid->getGridNodeVec();
+        auto gridPoints = userGrid->getGridPoints();
         auto mapCanvas = mapViewSubWidget->getMapCanvasWidget()->mapCanvas();
 
-        for(int i = 0; i<gridNodeVec.size(); ++i)
+        // The latitude and longitude of all of the nodes
+        QString transformErr;
+        auto geoPoints = ScreenToGeoTransform::toGeographic(mapCanvas, gridPoints, transformErr);
+        if(!transformErr.isEmpty())
+        {
+            this->errorMessage(transformErr);
+            return;
+        }
+
+        for(int i = 0; i<gridPoints.size(); ++i)
         {
-            auto gridNode = gridNodeVec.at(i);
 
             QStringList stationRow;
 
             // The station id
             stationRow.push_back(QString::number(i));
 
-            auto screenPoint = gridNode->getPoint();
-
-            // The latitude and longitude
-            auto longitude = theVisualizationWidget->getLongFromScreenPoint(screenPoint,mapCanvas);
-            auto latitude = theVisualizationWidget->getLatFromScreenPoint(screenPoint,mapCanvas);
+            auto latitude = geoPoints.at(i).y();
+            auto longitude = geoPoints.at(i).x();
 
             stationRow.push_back(QString::number(latitude));
             stationRow.push_back(QString::number(longitude));
@@ -945,15 +968,33 @@ void GMWidget::runHazardSimulation(void)
 
     this->getProgressDialog()->showProgressBar();
 
-    process->start(pythonPath, args);
-    //process->waitForStarted();
-    process->waitForFinished();
+    hazardRunner->start(pythonPath, args);
+}
+
+
+void GMWidget::cancelHazardSimulation(void)
+{
+    if(!hazardRunner->isRunning())
+        return;
+
+    this->statusMessage("Cancelling the hazard simulation");
+
+    hazardRunner->cancel();
 }
 
 
 void GMWidget::handleProcessFinished(int exitCode, QProcess::ExitStatus exitStatus)
 {
     this->m_runButton->setEnabled(true);
+    this->m_cancelButton->setEnabled(false);
+
+    if(hazardRunner->wasCancelled())
+    {
+        this->statusMessage("The hazard simulation was cancelled");
+        this->getProgressDialog()->hideProgressBar();
+
+        return;
+    }
 
     if(exitStatus == QProcess::ExitStatus::CrashExit)
     {
@@ -1020,14 +1061,19 @@ void GMWidget::handleProcessStarted(void)
 {
     this->statusMessage("Running script in the background");
     this->m_runButton->setEnabled(false);
+    this->m_cancelButton->setEnabled(true);
 }
 
 
-void GMWidget::handleProcessTextOutput(void)
+void GMWidget::handleProcessTextOutput(const QString& line)
 {
-    QByteArray output = process->readAllStandardOutput();
+    this->statusMessage(line);
+}
+
 
-    this->statusMessage(QString(output));
+void GMWidget::handleProcessProgress(const double percent, const QString& message)
+{
+    this->statusMessage("Hazard simulation " + QString::number(percent) + "% complete " + message);
 }
 
 
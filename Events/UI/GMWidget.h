@@ -43,6 +43,8 @@ UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 #include "PeerNgaWest2Client.h"
 #include "EventGMDirWidget.h"
 
+#include "ProcessRunner.h"
+
 #include <QProcess>
 #include <QJsonObject>
 
@@ -108,8 +110,14 @@ public slots:
     // Brings up the dialog and tells the user that the process has started
     void handleProcessStarted(void);
 
-    // Displays the text output of the process in the dialog
-    void handleProcessTextOutput(void);
+    // Displays the text output of the process in the dialog, one line at a time
+    void handleProcessTextOutput(const QString& line);
+
+    // Displays the progress reported by the process
+    void handleProcessProgress(const double percent, const QString& message);
+
+    // Stops the hazard simulation if it is running
+    void cancelHazardSimulation(void);
 
     // Download records once selected
     int downloadRecords(void);
@@ -134,7 +142,7 @@ private:
     RuptureWidget* m_ruptureWidget;
     GMPE* m_gmpe;
     GMPEWidget* m_gmpeWidget;
-    QProcess* process;
+    ProcessRunner* hazardRunner;
     IntensityMeasure* m_intensityMeasure;
     IntensityMeasureWidget* m_intensityMeasureWidget;
     SpatialCorrelationWidget* spatialCorrWidget;
@@ -143,6 +151,7 @@ private:
     SiteConfig* m_siteConfig;
     SiteConfigWidget* m_siteConfigWidget;
     QPushButton* m_runButton;
+    QPushButton* m_cancelButton;
     //QPushButton* m_settingButton;
     GmAppConfig* m_appConfig;
     Vs30* m_vs30;
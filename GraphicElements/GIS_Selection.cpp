@@ -41,6 +41,7 @@ UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 #include "SimCenterMapcanvasWidget.h"
 #include <PlainRectangle.h>
 #include "GridNode.h"
+#include "ScreenToGeoTransform.h"
 #include <qgsmapcanvas.h>
 /*
 #include <qgsvectorlayer.h>
@@ -232,15 +233,26 @@ GIS_Selection::handleSelectionGeometryChange(void)
       auto gridNodeVec = userGrid->getGridNodeVec();
       QgsMapCanvas *mapCanvas = mapViewSubWidget->mapCanvas();
 
-        for(int i = 0; i<gridNodeVec.size(); ++i)
+        QVector<QPointF> screenPoints;
+        screenPoints.reserve(gridNodeVec.size());
+        for(auto&& gridNode : gridNodeVec)
+            screenPoints.append(gridNode->getPoint());
+
+        // The latitude and longitude of all of the nodes
+        QString transformErr;
+        auto geoPoints = ScreenToGeoTransform::toGeographic(mapCanvas, screenPoints, transformErr);
+        if(!transformErr.isEmpty())
         {
+            this->errorMessage(transformErr);
+            return;
+        }
 
-            auto gridNode = gridNodeVec.at(i);
-            auto screenPoint = gridNode->getPoint();
+        selectedPoints.reserve(2*screenPoints.size());
 
-            // The latitude and longitude
-            auto longitude = theVisualizationWidget->getLongFromScreenPoint(screenPoint,mapCanvas);
-            auto latitude = theVisualizationWidget->getLatFromScreenPoint(screenPoint,mapCanvas);
+        for(int i = 0; i<screenPoints.size(); ++i)
+        {
+            auto latitude = geoPoints.at(i).y();
+            auto longitude = geoPoints.at(i).x();
             selectedPoints.append(latitude);
             selectedPoints.append(longitude);
              qDebug() << i << " " << latitude << " " << longitude;
@@ -37,7 +37,6 @@ UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 
 // Written: Stevan Gavrilovic
 
-#include "GridNode.h"
 #include "NodeHandle.h"
 #include "RectangleGrid.h"
 #include "SiteConfig.h"
@@ -79,6 +78,9 @@ RectangleGrid::RectangleGrid(QgsMapCanvas* parent) : QgsMapTool(parent), mapCanv
 
     color.setRgb(0,0,255,30);
 
+    nodeColor.setRgb(0,0,255,100);
+    nodeDiameter = 5.0;
+
     auto width = 150;
     auto height = 150;
 
@@ -260,6 +262,13 @@ void RectangleGrid::paint(QPainter *painter, const QStyleOptionGraphicsItem *opt
     painter->setPen(Qt::NoPen);
     painter->setBrush(QBrush(color));
     painter->drawRect(rectangleGeometry);
+
+    if(gridPoints.isEmpty())
+        return;
+
+    // All of the nodes in one call, a round pen gives the same discs as drawing an ellipse per node
+    painter->setPen(QPen(nodeColor, nodeDiameter, Qt::SolidLine, Qt::RoundCap));
+    painter->drawPoints(gridPoints.constData(), gridPoints.size());
 }
 
 
@@ -287,6 +296,8 @@ void RectangleGrid::updateGeometry(void)
         gridSiteConfig->siteGrid().longitude().set(lonMin, lonMax, numDivisionsVertical);
     }
 
+    this->updateGridPoints();
+
     // qDebug() << "RectangleRrid - emitting geometryChanged()";
     // qDebug() << mapCanvas->extent().toRectF();
     
@@ -294,9 +305,9 @@ void RectangleGrid::updateGeometry(void)
 }
 
 
-QVector<GridNode *> RectangleGrid::getGridNodeVec() const
+QVector<QPointF> RectangleGrid::getGridPoints() const
 {
-    return gridNodeVec;
+    return gridPoints;
 }
 
 
@@ -533,13 +544,15 @@ void RectangleGrid::handleCenterNodeChanged(const QPointF& pos)
     bottomRightNode->setPos(rectangleGeometry.bottomRight());
     topRightNode->setPos(rectangleGeometry.topRight());
     topLeftNode->setPos(rectangleGeometry.topLeft());
+
+    this->updateGridPoints();
 }
 
 
 void RectangleGrid::clearGrid()
 {
-    qDeleteAll(gridNodeVec);
-    gridNodeVec.clear();
+    gridPoints.clear();
+    this->update();
 }
 
 
@@ -548,56 +561,44 @@ void RectangleGrid::createGrid()
     auto ni = numDivisionsHoriz;
     auto nj = numDivisionsVertical;
 
-    gridNodeVec.reserve(ni*nj);
-
-    for (size_t i=0; i<=ni; ++i)
-    {
-        for (size_t j=0;j<=nj; ++j)
-        {
-
-            // X COORDINATE
-            std::function<double(void)> xCoordinatelambda = [=]
-            {
-                auto divisor = static_cast<double>(ni*nj);
+    gridPoints.resize(static_cast<int>((ni+1)*(nj+1)));
 
-                auto n1X = bottomLeftNode->pos().x();
-                auto n2X = bottomRightNode->pos().x();
-                auto n3X = topRightNode->pos().x();
-                auto n4X = topLeftNode->pos().x();
-
-                return static_cast<double>(i*j*n1X-i*j*n2X+i*j*n3X-i*j*n4X-i*n1X*nj+i*n2X*nj-j*n1X*ni+j*n4X*ni+n1X*ni*nj)/(divisor);
-            };
-
-            // Y COORDINATE
-            std::function<double(void)> yCoordinatelambda = [=]
-            {
-                auto divisor = static_cast<double>(ni*nj);
+    this->updateGridPoints();
+}
 
-                auto n1Y = bottomLeftNode->pos().y();
-                auto n2Y = bottomRightNode->pos().y();
-                auto n3Y = topRightNode->pos().y();
-                auto n4Y = topLeftNode->pos().y();
 
-                return static_cast<double>(i*j*n1Y-i*j*n2Y+i*j*n3Y-i*j*n4Y-i*n1Y*nj+i*n2Y*nj-j*n1Y*ni+j*n4Y*ni+n1Y*ni*nj)/(divisor);
-            };
+void RectangleGrid::updateGridPoints(void)
+{
+    if(gridPoints.isEmpty())
+        return;
 
-            auto x = xCoordinatelambda();
-            auto y = yCoordinatelambda();
+    auto ni = numDivisionsHoriz;
+    auto nj = numDivisionsVertical;
 
-            // Create the grid node
-            GridNode* newGridNode = new GridNode(this);
+    const auto n1 = bottomLeftNode->pos();
+    const auto n2 = bottomRightNode->pos();
+    const auto n3 = topRightNode->pos();
+    const auto n4 = topLeftNode->pos();
 
-            newGridNode->setX(x);
-            newGridNode->setY(y);
+    // Bilinear interpolation between the corners, node (i,j) is at index i*(nj+1)+j
+    auto pnt = gridPoints.data();
+    for (size_t i=0; i<=ni; ++i)
+    {
+        auto u = ni > 0 ? static_cast<double>(i)/ni : 0.0;
 
-            newGridNode->setXPos(xCoordinatelambda);
-            newGridNode->setYPos(yCoordinatelambda);
+        // The points at this division along the edges from n1 to n2 and from n4 to n3
+        auto start = n1 + u*(n2 - n1);
+        auto end = n4 + u*(n3 - n4);
 
-            gridNodeVec.push_back(newGridNode);
+        for (size_t j=0;j<=nj; ++j)
+        {
+            auto v = nj > 0 ? static_cast<double>(j)/nj : 0.0;
 
-            connect(this,&RectangleGrid::geometryChanged,newGridNode,&GridNode::updateGeometry);
+            *pnt++ = start + v*(end - start);
         }
     }
+
+    this->update();
 }
 
 
@@ -45,7 +45,6 @@ UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 
 class QgsMapCanvas;
 class NodeHandle;
-class GridNode;
 class SiteConfig;
 class VisualizationWidget;
 
@@ -59,7 +58,8 @@ class RectangleGrid : public QgsMapTool, public QGraphicsItem
     RectangleGrid(QgsMapCanvas* parent);
     ~RectangleGrid();
 
-    QVector<GridNode *> getGridNodeVec() const;
+    // Returns the locations of the grid nodes in screen coordinates, ordered by the horizontal division first
+    QVector<QPointF> getGridPoints() const;
     void setVisualizationWidget(VisualizationWidget *value);
     void clearGrid();
     void createGrid();
@@ -123,6 +123,9 @@ protected:
 
     void updateGeometry(void);
 
+    // Recomputes all of the grid node locations from the four corner nodes
+    void updateGridPoints(void);
+
 signals:
     void geometryChanged();
 
@@ -144,7 +147,10 @@ private:
     SiteConfig* gridSiteConfig;
     VisualizationWidget* theVisWidget;
 
-    QVector<GridNode*> gridNodeVec;
+    // The grid nodes are drawn by this item, only their locations are stored
+    QVector<QPointF> gridPoints;
+    QColor nodeColor;
+    double nodeDiameter;
 
     double latMin;
     double lonMin;
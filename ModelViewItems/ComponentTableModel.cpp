@@ -40,6 +40,7 @@ UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 
 #include <QDataStream>
 #include <QDebug>
+#include <QLocale>
 #include <QMimeData>
 #include <QStringList>
 #include <QUuid>
@@ -60,13 +61,20 @@ ComponentTableModel::~ComponentTableModel()
 // Create a method to populate the model with data:
 void ComponentTableModel::populateData(const QVector<QStringList>& data, const QStringList& header)
 {
-    tableData = data;
-    headerStringList = header;
+    this->populateData(ColumnarTable::fromStringRows(data, header));
+}
+
+
+void ComponentTableModel::populateData(ColumnarTable&& data)
+{
+    this->beginResetModel();
+
+    tableData = std::move(data);
 
     numRows = rowCount();
     numCols = columnCount();
 
-    emit layoutChanged();
+    this->endResetModel();
 
     return;
 }
@@ -74,11 +82,14 @@ void ComponentTableModel::populateData(const QVector<QStringList>& data, const Q
 
 void ComponentTableModel::clear(void)
 {
+    this->beginResetModel();
+
     numRows = 0;
     numCols = 0;
 
     tableData.clear();
-    headerStringList.clear();
+
+    this->endResetModel();
 }
 
 
@@ -96,7 +107,7 @@ Qt::ItemFlags ComponentTableModel::flags(const QModelIndex &index) const
 int ComponentTableModel::rowCount(const QModelIndex &parent) const
 {
     Q_UNUSED(parent);
-    return tableData.size();
+    return tableData.rowCount();
 }
 
 
@@ -107,19 +118,35 @@ int ComponentTableModel::columnCount(const QModelIndex &parent) const
     if(tableData.isEmpty())
         return 0;
 
-    return tableData.front().size();
+    return tableData.columnCount();
 }
 
 
 QVariant ComponentTableModel::data(const QModelIndex &index, int role) const
 {
-    if (!index.isValid() || role != Qt::DisplayRole)
+    if (!index.isValid())
         return QVariant();
 
     auto col = index.column();
     auto row = index.row();
 
-    return this->item(row,col);
+    // Cells are served straight from the typed table, only for the rows that the view asks for
+    // The text of the cell is shown and edited rather than the typed value, so that the default delegate does not round the doubles or group the digits of the integers
+    // Sorting is done on the typed values by the proxy model
+    switch(role)
+    {
+    case Qt::DisplayRole:
+    case Qt::EditRole:
+        if(col>= numCols || row>= numRows || row < 0 || col < 0)
+            return QVariant();
+        return tableData.stringValue(row,col);
+    case Qt::TextAlignmentRole:
+        if(col < numCols && tableData.columnType(col) != ColumnarTable::StringColumn)
+            return QVariant(Qt::AlignRight | Qt::AlignVCenter);
+        return QVariant();
+    default:
+        return QVariant();
+    }
 }
 
 
@@ -134,13 +161,15 @@ bool ComponentTableModel::setData(const QModelIndex &index, const QVariant &valu
     if(col>= numCols || row>= numRows || row < 0 || col < 0)
         return false;
 
-    auto strVal = value.toString();
+    // A double from a typed editor is written as the shortest text that reads back to the same value, so that no digits are lost
+    auto strVal = value.type() == QVariant::Double ? QString::number(value.toDouble(),'g',QLocale::FloatingPointShortest) : value.toString();
 
-    if(!strVal.isEmpty())
-    {
-        tableData[row][col] = strVal;
-        emit handleCellChanged(row,col);
-    }
+    // An edit that leaves the text of the cell as it was is not a change
+    if(strVal.isEmpty() || strVal == tableData.stringValue(row,col))
+        return true;
+
+    tableData.setValue(row,col,strVal);
+    emit handleCellChanged(row,col);
 
     return true;
 }
@@ -148,11 +177,11 @@ bool ComponentTableModel::setData(const QModelIndex &index, const QVariant &valu
 
 QVariant ComponentTableModel::headerData(int section, Qt::Orientation orientation, int role) const
 {
-    if(headerStringList.isEmpty())
+    if(section < 0 || section >= tableData.columnCount())
         return QVariant();
 
     if (role == Qt::DisplayRole && orientation == Qt::Horizontal)
-        return headerStringList[section];
+        return tableData.getHeader().at(section);
 
     return QVariant();
 }
@@ -163,11 +192,17 @@ QVariant ComponentTableModel::item(const int row, const int col) const
     if(col>= numCols || row>= numRows || row < 0 || col < 0)
         return QVariant();
 
-    return tableData[row][col];
+    return tableData.value(row,col);
+}
+
+
+QVector<QStringList> ComponentTableModel::getTableData() const
+{
+    return tableData.toStringRows();
 }
 
 
-QVector<QStringList>& ComponentTableModel::getTableData()
+const ColumnarTable& ComponentTableModel::getTable() const
 {
     return tableData;
 }
@@ -175,5 +210,5 @@ QVector<QStringList>& ComponentTableModel::getTableData()
 
 QStringList ComponentTableModel::getHeaderStringList() const
 {
-    return headerStringList;
+    return tableData.getHeader();
 }
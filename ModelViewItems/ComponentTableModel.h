@@ -38,6 +38,8 @@ UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 
 // Written by: Dr. Stevan Gavrilovic, UC Berkeley
 
+#include "ColumnarTable.h"
+
 #include <QAbstractTableModel>
 
 class ComponentTableModel : public QAbstractTableModel
@@ -57,6 +59,9 @@ public:
 
     void populateData(const QVector<QStringList>& data, const QStringList& header);
 
+    // Takes over a typed table, the table header is used as the header of the model
+    void populateData(ColumnarTable&& data);
+
     int rowCount(const QModelIndex &parent = QModelIndex()) const Q_DECL_OVERRIDE;
 
     int columnCount(const QModelIndex &parent = QModelIndex()) const Q_DECL_OVERRIDE;
@@ -65,7 +70,10 @@ public:
 
     QVariant item(const int row, const int col) const;
 
-    QVector<QStringList>& getTableData();
+    // Returns a copy of the table data as strings, use getTable() to access the typed values
+    QVector<QStringList> getTableData() const;
+
+    const ColumnarTable& getTable() const;
 
     QStringList getHeaderStringList() const;
 
@@ -75,8 +83,7 @@ signals:
 
 private:
 
-    QVector<QStringList> tableData;
-    QStringList headerStringList;
+    ColumnarTable tableData;
 
     int numRows;
     int numCols;
@@ -0,0 +1,143 @@
+/* *****************************************************************************
+Copyright (c) 2016-2021, The Regents of the University of California (Regents).
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those
+of the authors and should not be interpreted as representing official policies,
+either expressed or implied, of the FreeBSD Project.
+
+REGENTS SPECIFICALLY DISCLAIMS ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+THE SOFTWARE AND ACCOMPANYING DOCUMENTATION, IF ANY, PROVIDED HEREUNDER IS
+PROVIDED "AS IS". REGENTS HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+
+*************************************************************************** */
+
+
+#include "ComponentTableProxyModel.h"
+#include "ComponentTableModel.h"
+
+#include <algorithm>
+
+ComponentTableProxyModel::ComponentTableProxyModel(QObject *parent) : QSortFilterProxyModel(parent)
+{
+
+}
+
+
+void ComponentTableProxyModel::setSourceTableModel(ComponentTableModel* model)
+{
+    tableModel = model;
+
+    this->setSourceModel(model);
+
+    // The row filter belongs to the previous contents of the table
+    connect(model, &QAbstractItemModel::modelReset, this, [this](){
+        visibleRows.clear();
+    });
+}
+
+
+void ComponentTableProxyModel::setVisibleRows(const ComponentIDSet& rows)
+{
+    auto numRows = tableModel ? tableModel->rowCount() : 0;
+
+    QVector<bool> newVisibleRows(numRows, false);
+
+    // Fill in the flags a range at a time
+    for(auto&& range : rows.getRanges())
+    {
+        auto first = std::max(range.first, 0);
+        auto last = std::min(range.last, numRows-1);
+
+        if(first <= last)
+            std::fill(newVisibleRows.begin()+first, newVisibleRows.begin()+last+1, true);
+    }
+
+    visibleRows.swap(newVisibleRows);
+
+    this->invalidateFilter();
+}
+
+
+void ComponentTableProxyModel::clearVisibleRows(void)
+{
+    if(visibleRows.isEmpty())
+        return;
+
+    visibleRows.clear();
+
+    this->invalidateFilter();
+}
+
+
+bool ComponentTableProxyModel::isRowFilterActive(void) const
+{
+    return !visibleRows.isEmpty();
+}
+
+
+bool ComponentTableProxyModel::filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const
+{
+    if(!visibleRows.isEmpty() && (sourceRow >= visibleRows.size() || !visibleRows.at(sourceRow)))
+        return false;
+
+    // Only go through the text filter of the base class if one is set
+    if(this->filterRegularExpression().pattern().isEmpty())
+        return true;
+
+    return QSortFilterProxyModel::filterAcceptsRow(sourceRow, sourceParent);
+}
+
+
+bool ComponentTableProxyModel::lessThan(const QModelIndex &sourceLeft, const QModelIndex &sourceRight) const
+{
+    if(tableModel == nullptr)
+        return QSortFilterProxyModel::lessThan(sourceLeft, sourceRight);
+
+    const auto& table = tableModel->getTable();
+
+    auto col = sourceLeft.column();
+    auto leftRow = sourceLeft.row();
+    auto rightRow = sourceRight.row();
+
+    // Empty cells sort before any value
+    auto leftNull = table.isNull(leftRow, col);
+    auto rightNull = table.isNull(rightRow, col);
+
+    if(leftNull || rightNull)
+        return leftNull && !rightNull;
+
+    switch(table.columnType(col))
+    {
+    case ColumnarTable::Int64Column:
+        return table.int64Value(leftRow, col) < table.int64Value(rightRow, col);
+    case ColumnarTable::DoubleColumn:
+        return table.doubleValue(leftRow, col) < table.doubleValue(rightRow, col);
+    case ColumnarTable::StringColumn:
+        return QString::localeAwareCompare(table.stringValue(leftRow, col), table.stringValue(rightRow, col)) < 0;
+    }
+
+    return false;
+}
@@ -37,6 +37,7 @@ UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 // Written by: Dr. Stevan Gavrilovic, UC Berkeley
 
 #include "ComponentTableModel.h"
+#include "ComponentTableProxyModel.h"
 #include "ComponentTableView.h"
 #include "VisualizationWidget.h"
 
@@ -47,8 +48,16 @@ UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 
 ComponentTableView::ComponentTableView(QWidget *parent) : QTableView(parent)
 {
-    tableModel = new ComponentTableModel();
-    this->setModel(tableModel);
+    tableModel = new ComponentTableModel(this);
+
+    // The view shows the table through a proxy that does the sorting and filtering
+    proxyModel = new ComponentTableProxyModel(this);
+    proxyModel->setSourceTableModel(tableModel);
+    this->setModel(proxyModel);
+
+    // Start out in the order of the table model, sorting happens when a column header is clicked
+    this->horizontalHeader()->setSortIndicator(-1, Qt::AscendingOrder);
+    this->setSortingEnabled(true);
 
     this->hide();
     this->setToolTip("Component details");
@@ -100,7 +109,25 @@ ComponentTableModel *ComponentTableView::getTableModel() const
 }
 
 
+ComponentTableProxyModel *ComponentTableView::getProxyModel() const
+{
+    return proxyModel;
+}
+
+
 QVariant ComponentTableView::item(int row, int col)
 {
     return tableModel->item(row,col);
 }
+
+
+void ComponentTableView::setVisibleRows(const ComponentIDSet& rows)
+{
+    proxyModel->setVisibleRows(rows);
+}
+
+
+void ComponentTableView::clearVisibleRows(void)
+{
+    proxyModel->clearVisibleRows();
+}
@@ -41,7 +41,10 @@ UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 #include <QTableView>
 #include <QDebug>
 
+#include "ComponentIDSet.h"
+
 class ComponentTableModel;
+class ComponentTableProxyModel;
 
 class ComponentTableView : public QTableView
 {
@@ -61,11 +64,21 @@ public:
 
     ComponentTableModel *getTableModel() const;
 
+    ComponentTableProxyModel *getProxyModel() const;
+
+    // The row and column are those of the table model, regardless of how the view is sorted or filtered
     QVariant item(int row, int col);
 
+    // Only shows the given rows of the table model
+    void setVisibleRows(const ComponentIDSet& rows);
+
+    void clearVisibleRows(void);
+
 private:
 
     ComponentTableModel* tableModel;
+
+    ComponentTableProxyModel* proxyModel;
 };
 
 #endif // ComponentTableView_H
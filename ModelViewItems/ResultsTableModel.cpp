@@ -0,0 +1,256 @@
+/* *****************************************************************************
+Copyright (c) 2016-2021, The Regents of the University of California (Regents).
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those
+of the authors and should not be interpreted as representing official policies,
+either expressed or implied, of the FreeBSD Project.
+
+REGENTS SPECIFICALLY DISCLAIMS ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+THE SOFTWARE AND ACCOMPANYING DOCUMENTATION, IF ANY, PROVIDED HEREUNDER IS
+PROVIDED "AS IS". REGENTS HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+
+*************************************************************************** */
+
+
+#include "ResultsTableModel.h"
+
+#include <algorithm>
+#include <numeric>
+
+ResultsTableModel::ResultsTableModel(QObject *parent) : QAbstractTableModel(parent)
+{
+    sortColumn = -1;
+    sortOrder = Qt::AscendingOrder;
+    rowOrderIsValid = true;
+}
+
+
+ResultsTableModel::~ResultsTableModel()
+{
+
+}
+
+
+void ResultsTableModel::populateData(ColumnarTable&& data)
+{
+    this->beginResetModel();
+
+    tableData = std::move(data);
+
+    sortColumn = -1;
+    sortOrder = Qt::AscendingOrder;
+    rowOrder.clear();
+    rowOrderIsValid = true;
+
+    this->endResetModel();
+}
+
+
+void ResultsTableModel::clear(void)
+{
+    this->populateData(ColumnarTable());
+}
+
+
+Qt::ItemFlags ResultsTableModel::flags(const QModelIndex &index) const
+{
+    if(!index.isValid())
+        return Qt::NoItemFlags;
+
+    return Qt::ItemIsSelectable | Qt::ItemIsEnabled;
+}
+
+
+int ResultsTableModel::rowCount(const QModelIndex &parent) const
+{
+    if(parent.isValid())
+        return 0;
+
+    return tableData.rowCount();
+}
+
+
+int ResultsTableModel::columnCount(const QModelIndex &parent) const
+{
+    if(parent.isValid())
+        return 0;
+
+    return tableData.columnCount();
+}
+
+
+QVariant ResultsTableModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid())
+        return QVariant();
+
+    auto col = index.column();
+    auto row = index.row();
+
+    if(col >= tableData.columnCount() || row >= tableData.rowCount() || row < 0 || col < 0)
+        return QVariant();
+
+    switch(role)
+    {
+    case Qt::DisplayRole:
+        return tableData.value(this->tableRow(row),col);
+    case Qt::TextAlignmentRole:
+        if(tableData.columnType(col) != ColumnarTable::StringColumn)
+            return QVariant(Qt::AlignRight | Qt::AlignVCenter);
+        return QVariant();
+    default:
+        return QVariant();
+    }
+}
+
+
+QVariant ResultsTableModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if(section < 0 || section >= tableData.columnCount())
+        return QVariant();
+
+    if (role == Qt::DisplayRole && orientation == Qt::Horizontal)
+        return tableData.getHeader().at(section);
+
+    return QVariant();
+}
+
+
+void ResultsTableModel::sort(int column, Qt::SortOrder order)
+{
+    if(column < 0 || column >= tableData.columnCount())
+        return;
+
+    if(column == sortColumn && order == sortOrder)
+        return;
+
+    emit layoutAboutToBeChanged(QList<QPersistentModelIndex>(), QAbstractItemModel::VerticalSortHint);
+
+    sortColumn = column;
+    sortOrder = order;
+
+    // The permutation is rebuilt the next time that a view asks for the data
+    rowOrderIsValid = false;
+
+    emit layoutChanged(QList<QPersistentModelIndex>(), QAbstractItemModel::VerticalSortHint);
+}
+
+
+const ColumnarTable& ResultsTableModel::getTable() const
+{
+    return tableData;
+}
+
+
+int ResultsTableModel::tableRow(const int row) const
+{
+    if(!rowOrderIsValid)
+        this->updateRowOrder();
+
+    if(rowOrder.isEmpty())
+        return row;
+
+    return rowOrder.at(row);
+}
+
+
+void ResultsTableModel::updateRowOrder(void) const
+{
+    rowOrderIsValid = true;
+
+    rowOrder.resize(tableData.rowCount());
+    std::iota(rowOrder.begin(), rowOrder.end(), 0);
+
+    const auto col = sortColumn;
+    const bool descending = (sortOrder == Qt::DescendingOrder);
+
+    // Null cells are placed last in either order, ties keep the order of the table
+    auto compareNulls = [&](const int a, const int b, bool& result)
+    {
+        auto aIsNull = tableData.isNull(a,col);
+        auto bIsNull = tableData.isNull(b,col);
+
+        if(!aIsNull && !bIsNull)
+            return false;
+
+        result = !aIsNull && bIsNull;
+
+        return true;
+    };
+
+    switch(tableData.columnType(col))
+    {
+    case ColumnarTable::Int64Column:
+    {
+        std::stable_sort(rowOrder.begin(), rowOrder.end(), [&](const int a, const int b)
+        {
+            bool result;
+            if(compareNulls(a,b,result))
+                return result;
+
+            auto aVal = tableData.int64Value(a,col);
+            auto bVal = tableData.int64Value(b,col);
+
+            return descending ? bVal < aVal : aVal < bVal;
+        });
+        break;
+    }
+    case ColumnarTable::DoubleColumn:
+    {
+        std::stable_sort(rowOrder.begin(), rowOrder.end(), [&](const int a, const int b)
+        {
+            bool result;
+            if(compareNulls(a,b,result))
+                return result;
+
+            auto aVal = tableData.doubleValue(a,col);
+            auto bVal = tableData.doubleValue(b,col);
+
+            return descending ? bVal < aVal : aVal < bVal;
+        });
+        break;
+    }
+    case ColumnarTable::StringColumn:
+    {
+        // Look up the strings once per row instead of once per comparison
+        QVector<QString> values(tableData.rowCount());
+        for(int i = 0; i<tableData.rowCount(); ++i)
+            values[i] = tableData.stringValue(i,col);
+
+        std::stable_sort(rowOrder.begin(), rowOrder.end(), [&](const int a, const int b)
+        {
+            bool result;
+            if(compareNulls(a,b,result))
+                return result;
+
+            auto cmp = QString::localeAwareCompare(values.at(a), values.at(b));
+
+            return descending ? cmp > 0 : cmp < 0;
+        });
+        break;
+    }
+    }
+}
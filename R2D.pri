@@ -36,6 +36,13 @@
 
 # Written by: Stevan Gavrilovic
 
+# Optional HDF5 output of the hazard event grids, turned on when pkg-config can find the HDF5 library
+unix:packagesExist(hdf5) {
+    CONFIG += link_pkgconfig
+    PKGCONFIG += hdf5
+    DEFINES += INCLUDE_HDF5
+}
+
 
 
 INCLUDEPATH += $$PWD \
@@ -95,12 +102,24 @@ SOURCES +=  $$PWD/Events/UI/EarthquakeRuptureForecast.cpp \
             $$PWD/Events/UI/Vs30Widget.cpp \
             $$PWD/ModelViewItems/ComponentTableModel.cpp \
             $$PWD/ModelViewItems/ComponentTableView.cpp \
+            $$PWD/ModelViewItems/ComponentTableProxyModel.cpp \
+            $$PWD/ModelViewItems/ResultsTableModel.cpp \
             $$PWD/ModelViewItems/ListTreeModel.cpp \
             $$PWD/ModelViewItems/CustomListWidget.cpp \
             $$PWD/Tools/AssetInputDelegate.cpp \
             $$PWD/Tools/AssetFilterDelegate.cpp \
             $$PWD/Tools/ComponentDatabase.cpp \
             $$PWD/Tools/CSVReaderWriter.cpp \
+            $$PWD/Tools/ColumnarTable.cpp \
+            $$PWD/Tools/EventGridFile.cpp \
+            $$PWD/Tools/HurricaneDatabaseCache.cpp \
+            $$PWD/Tools/AsyncLogSink.cpp \
+            $$PWD/Tools/ProcessRunner.cpp \
+            $$PWD/Tools/EventGridHdf5File.cpp \
+            $$PWD/Tools/ComponentIDSet.cpp \
+            $$PWD/Tools/GeoJSONFeatureSplitter.cpp \
+            $$PWD/Tools/ResultsAggregator.cpp \
+            $$PWD/Tools/TDigest.cpp \
             $$PWD/Tools/GeoJSONReaderWriter.cpp \
             $$PWD/Tools/ComponentDatabaseManager.cpp \
             $$PWD/Tools/NGAW2Converter.cpp \
@@ -224,6 +243,16 @@ HEADERS +=  $$PWD/Events/UI/EarthquakeRuptureForecast.h \
             $$PWD/Tools/AssetFilterDelegate.h \
             $$PWD/Tools/ComponentDatabase.h \
             $$PWD/Tools/CSVReaderWriter.h \
+            $$PWD/Tools/ColumnarTable.h \
+            $$PWD/Tools/EventGridFile.h \
+            $$PWD/Tools/HurricaneDatabaseCache.h \
+            $$PWD/Tools/AsyncLogSink.h \
+            $$PWD/Tools/ProcessRunner.h \
+            $$PWD/Tools/EventGridHdf5File.h \
+            $$PWD/Tools/ComponentIDSet.h \
+            $$PWD/Tools/GeoJSONFeatureSplitter.h \
+            $$PWD/Tools/ResultsAggregator.h \
+            $$PWD/Tools/TDigest.h \
             $$PWD/Tools/GeoJSONReaderWriter.h \
             $$PWD/Tools/ComponentDatabaseManager.h \
             $$PWD/Tools/NGAW2Converter.h \
@@ -296,6 +325,8 @@ HEADERS +=  $$PWD/Events/UI/EarthquakeRuptureForecast.h \
             $$PWD/ModelViewItems/CustomListWidget.h \
             $$PWD/ModelViewItems/ComponentTableModel.h \
             $$PWD/ModelViewItems/ComponentTableView.h \
+            $$PWD/ModelViewItems/ComponentTableProxyModel.h \
+            $$PWD/ModelViewItems/ResultsTableModel.h \
             $$PWD/ModelViewItems/ListTreeModel.h \
             $$PWD/GraphicElements/GridNode.h \
             $$PWD/GraphicElements/NodeHandle.h \
@@ -352,6 +383,9 @@ HEADERS +=  $$PWD/Events/UI/EarthquakeRuptureForecast.h \
 # Add QGIS sources and headers
 
 SOURCES +=  $$PWD/Tools/QGISHurricanePreprocessor.cpp \
+            $$PWD/Tools/SpatialBoxIndex.cpp \
+            $$PWD/Tools/RasterBlockSampler.cpp \
+            $$PWD/Tools/ScreenToGeoTransform.cpp \
             $$PWD/UIWidgets/LineAssetInputWidget.cpp \
             $$PWD/UIWidgets/PointAssetInputWidget.cpp \
             $$PWD/UIWidgets/CSVWaterNetworkInputWidget.cpp \
@@ -367,6 +401,9 @@ SOURCES +=  $$PWD/Tools/QGISHurricanePreprocessor.cpp \
 #            $$PWD/ModelViewItems/LayerTreeView.cpp \
 
 HEADERS +=  $$PWD/Tools/QGISHurricanePreprocessor.h \
+            $$PWD/Tools/SpatialBoxIndex.h \
+            $$PWD/Tools/RasterBlockSampler.h \
+            $$PWD/Tools/ScreenToGeoTransform.h \
             $$PWD/UIWidgets/LineAssetInputWidget.h \
             $$PWD/UIWidgets/PointAssetInputWidget.h \
             $$PWD/UIWidgets/CSVWaterNetworkInputWidget.h \
@@ -41,11 +41,39 @@ UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 #include "MainWindowWorkflowApp.h"
 #include "LocalApplication.h"
 #include "SimCenterPreferences.h"
+#include "SpatialBoxIndex.h"
+#include "RasterBlockSampler.h"
+#include "ComponentIDSet.h"
+#include "CSVReaderWriter.h"
+#include "ColumnarTable.h"
+#include "ComponentTableModel.h"
+#include "EventGridFile.h"
+#include "EventGridHdf5File.h"
+#include "ProcessRunner.h"
+#include "ResultsAggregator.h"
+#include "REmpiricalProbabilityDistribution.h"
+
+#include <qgsrasterfilewriter.h>
+#include <qgsrasterdataprovider.h>
+#include <qgsrasterlayer.h>
+#include <qgsrasterblock.h>
+
+#ifdef INCLUDE_HDF5
+#include <hdf5.h>
+#endif
 
 #include <QRegExp>
+#include <QElapsedTimer>
+#include <QTemporaryDir>
 #include <QCoreApplication>
 #include <QtTest/QtTest>
 
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <random>
+#include <set>
+
 class R2DUnitTests: public QObject
 {
 
@@ -78,9 +106,27 @@ public:
 
 private slots:
     void testExamples();
+    void benchmarkSpatialBoxIndex();
+    void benchmarkRasterBlockSampler();
+    void testComponentIDSet();
+    void testEmpiricalProbabilityDistribution();
+    void testCSVReaderWriter();
+    void testColumnarTable();
+    void testComponentTableModel();
+    void testEventGridFile();
+    void testEventGridHdf5File();
+    void testProcessRunner();
+    void testResultsAggregator();
 
 private:
 
+    // The line parser that CSVReaderWriter used before the block parallel parser, it parses one record at a time
+    static QStringList parseLineCSVReference(const QString& csvString);
+
+    // Linear congruential generator for the randomized tests, the caller holds the seed so that each run is repeatable
+    // Returns a value in [0,1)
+    static double nextRandom(quint32& seed);
+
     AgaveCurl *theRemoteService = nullptr;
     WorkflowAppR2D *theInputApp = nullptr;
     MainWindowWorkflowApp* mainWindow = nullptr;
@@ -196,5 +242,857 @@ void R2DUnitTests::testExamples()
 
 
 
+void R2DUnitTests::benchmarkSpatialBoxIndex()
+{
+    // Synthetic parcels on a 200 x 200 grid of unit boxes, with a slight overlap so that some points fall in more than one box
+    const int gridSize = 200;
+    const double overlap = 0.05;
+
+    QVector<QPair<QgsFeatureId,QgsRectangle>> parcels;
+    parcels.reserve(gridSize*gridSize);
+
+    SpatialBoxIndex parcelIndex;
+
+    for(int i = 0; i<gridSize; ++i)
+    {
+        for(int j = 0; j<gridSize; ++j)
+        {
+            QgsFeatureId id = i*gridSize + j;
+            QgsRectangle box(i - overlap, j - overlap, i + 1.0 + overlap, j + 1.0 + overlap);
+
+            parcels.append(qMakePair(id,box));
+            parcelIndex.insert(id, box);
+        }
+    }
+
+    QCOMPARE(parcelIndex.size(), gridSize*gridSize);
+
+    // Building centroids from a fixed seed so that the run is repeatable
+    const int numBuildings = 5000;
+    quint32 seed = 12345;
+
+    QVector<QgsPointXY> buildings;
+    buildings.reserve(numBuildings);
+    for(int i = 0; i<numBuildings; ++i)
+    {
+        // Some of the buildings fall outside of the grid
+        auto x = nextRandom(seed)*(gridSize + 2.0) - 1.0;
+        auto y = nextRandom(seed)*(gridSize + 2.0) - 1.0;
+        buildings.append(QgsPointXY(x,y));
+    }
+
+    // Brute force, the first parcel whose box contains the centroid
+    QElapsedTimer timer;
+    timer.start();
+
+    QVector<QgsFeatureId> bruteForceRes(numBuildings, FID_NULL);
+    for(int i = 0; i<numBuildings; ++i)
+    {
+        for(auto&& parcel : parcels)
+        {
+            if(parcel.second.contains(buildings.at(i)))
+            {
+                bruteForceRes[i] = parcel.first;
+                break;
+            }
+        }
+    }
+
+    auto bruteForceTime = timer.nsecsElapsed();
+
+    timer.restart();
+
+    QVector<QgsFeatureId> indexRes(numBuildings, FID_NULL);
+    for(int i = 0; i<numBuildings; ++i)
+        indexRes[i] = parcelIndex.firstContaining(buildings.at(i));
+
+    auto indexTime = timer.nsecsElapsed();
+
+    QCOMPARE(indexRes, bruteForceRes);
+
+    qDebug()<<"Brute force scan:"<<bruteForceTime/1.0e6<<"ms, spatial index:"<<indexTime/1.0e6<<"ms, speedup:"<<static_cast<double>(bruteForceTime)/qMax(indexTime,qint64(1));
+}
+
+
+
+void R2DUnitTests::benchmarkRasterBlockSampler()
+{
+    // Synthetic three band raster over a one degree square, with a value that depends on the band, row and column of each cell
+    // It is kept small so that the test runs quickly, it still has enough tiles to exercise the grouping of the points by tile
+    const int rasterSize = 600;
+    const int numBands = 3;
+    const QgsRectangle extent(-95.0, 29.0, -94.0, 30.0);
+
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    auto rasterPath = tempDir.filePath("benchmark.tif");
+
+    // A patch of no-data cells, which is in a different place in each band
+    const double noData = -9999.0;
+
+    {
+        QgsRasterFileWriter writer(rasterPath);
+        std::unique_ptr<QgsRasterDataProvider> writeProvider(writer.createMultiBandRaster(Qgis::DataType::Float32, rasterSize, rasterSize, extent, QgsCoordinateReferenceSystem("EPSG:4326"), numBands));
+        QVERIFY(writeProvider != nullptr);
+
+        for(int b = 1; b<=numBands; ++b)
+        {
+            QVERIFY(writeProvider->setNoDataValue(b, noData));
+
+            QgsRasterBlock block(Qgis::DataType::Float32, rasterSize, rasterSize);
+            for(int r = 0; r<rasterSize; ++r)
+                for(int c = 0; c<rasterSize; ++c)
+                {
+                    auto isNoData = r >= 100*b && r < 100*b + 40 && c >= 150 && c < 250;
+                    block.setValue(r, c, isNoData ? noData : b*100.0 + (r % 97)*0.5 + (c % 89)*0.25);
+                }
+
+            QVERIFY(writeProvider->writeBlock(&block, b, 0, 0));
+        }
+    }
+
+    QgsRasterLayer rasterLayer(rasterPath, "benchmark", "gdal");
+    QVERIFY(rasterLayer.isValid());
+
+    auto provider = rasterLayer.dataProvider();
+
+    // Asset locations from a fixed seed so that the run is repeatable
+    const int numPoints = 20000;
+    quint32 seed = 12345;
+
+    QVector<QgsPointXY> points;
+    points.reserve(numPoints);
+    for(int i = 0; i<numPoints; ++i)
+    {
+        // Some of the points fall outside of the raster
+        auto x = extent.xMinimum() - 0.01 + nextRandom(seed)*(extent.width() + 0.02);
+        auto y = extent.yMinimum() - 0.01 + nextRandom(seed)*(extent.height() + 0.02);
+        points.append(QgsPointXY(x,y));
+    }
+
+    QList<int> bands;
+    for(int b = 1; b<=numBands; ++b)
+        bands.append(b);
+
+    // One call to the provider per point and band, as the hazard widget used to do, where a point that could not be sampled was set to zero
+    QElapsedTimer timer;
+    timer.start();
+
+    QVector<double> pointValues(numPoints*numBands);
+    for(int i = 0; i<numPoints; ++i)
+    {
+        for(int b = 0; b<numBands; ++b)
+        {
+            bool OK = false;
+            auto val = provider->sample(points.at(i), bands.at(b), &OK);
+            pointValues[i*numBands + b] = OK ? val : 0.0;
+        }
+    }
+
+    auto pointTime = timer.nsecsElapsed();
+
+    timer.restart();
+
+    RasterBlockSampler sampler(provider);
+    sampler.setOutOfBoundsValue(0.0);
+    sampler.setNoDataValue(0.0);
+
+    QVector<double> blockValues;
+    QString err;
+    QCOMPARE(sampler.sample(points, bands, blockValues, err), 0);
+
+    auto blockTime = timer.nsecsElapsed();
+
+    QCOMPARE(blockValues.size(), pointValues.size());
+
+    int numMismatches = 0;
+    int numNaN = 0;
+    for(int i = 0; i<pointValues.size(); ++i)
+    {
+        if(pointValues.at(i) != blockValues.at(i))
+            ++numMismatches;
+
+        if(std::isnan(blockValues.at(i)))
+            ++numNaN;
+    }
+
+    QCOMPARE(numMismatches, 0);
+    QCOMPARE(numNaN, 0);
+    QVERIFY(sampler.getNumOutOfBounds() > 0);
+    QVERIFY(sampler.getNumNoData() > 0);
+
+    qDebug()<<"Per point sampling:"<<pointTime/1.0e6<<"ms, block sampling:"<<blockTime/1.0e6<<"ms, speedup:"<<static_cast<double>(pointTime)/qMax(blockTime,qint64(1));
+}
+
+
+
+void R2DUnitTests::testComponentIDSet()
+{
+    // A large range is stored as a single run
+    ComponentIDSet bigSelection;
+    bigSelection.insertRange(1, 1000000);
+    bigSelection.insert(5);
+    bigSelection.insert(1000002);
+
+    QCOMPARE(static_cast<int>(bigSelection.getRanges().size()), 2);
+    QCOMPARE(bigSelection.size(), qint64(1000001));
+    QCOMPARE(bigSelection.toString(), QString("1-1000000,1000002"));
+
+    // Inserting the gap merges the runs
+    bigSelection.insert(1000001);
+    QCOMPARE(bigSelection.toString(), QString("1-1000002"));
+
+    // Random ranges and single IDs against std::set, from a fixed seed so that the run is repeatable
+    quint32 seed = 12345;
+
+    for(int trial = 0; trial<500; ++trial)
+    {
+        ComponentIDSet idSet;
+        std::set<int> refSet;
+
+        auto numInserts = static_cast<int>(nextRandom(seed)*20);
+        for(int k = 0; k<numInserts; ++k)
+        {
+            auto first = static_cast<int>(nextRandom(seed)*60);
+            auto last = first + static_cast<int>(nextRandom(seed)*8);
+
+            idSet.insertRange(first, last);
+            for(int id = first; id<=last; ++id)
+                refSet.insert(id);
+        }
+
+        QVector<int> ids(idSet.begin(), idSet.end());
+        QVector<int> refIds(refSet.begin(), refSet.end());
+
+        QCOMPARE(ids, refIds);
+        QCOMPARE(idSet.size(), static_cast<qint64>(refSet.size()));
+
+        for(int id = -1; id<70; ++id)
+            QCOMPARE(idSet.contains(id), refSet.count(id) > 0);
+
+        // The runs stay sorted and separated by at least one missing ID
+        const auto& ranges = idSet.getRanges();
+        for(size_t i = 1; i<ranges.size(); ++i)
+            QVERIFY(ranges[i].first > ranges[i-1].last + 1);
+    }
+}
+
+
+
+void R2DUnitTests::testEmpiricalProbabilityDistribution()
+{
+    std::mt19937 generator(12345);
+
+    // Samples with a large offset, the sum of squares approach loses all of the precision of the variance here
+    std::normal_distribution<double> normalDist(1.0e9, 1.0);
+
+    REmpiricalProbabilityDistribution offsetDist;
+    for(int i = 0; i<100000; ++i)
+        offsetDist.addSample(normalDist(generator));
+
+    QVERIFY(std::fabs(offsetDist.mean() - 1.0e9) < 0.02);
+    QVERIFY(std::fabs(offsetDist.stdDev() - 1.0) < 0.02);
+
+    // The compensated sum does not accumulate the rounding error of 0.1
+    REmpiricalProbabilityDistribution constantDist;
+    for(int i = 0; i<1000000; ++i)
+        constantDist.addSample(0.1);
+
+    QVERIFY(std::fabs(constantDist.sum() - 100000.0) < 1.0e-6);
+    QCOMPARE(constantDist.stdDev(), 0.0);
+
+    // The extremes are taken from the samples, not from zero
+    REmpiricalProbabilityDistribution negativeDist;
+    QCOMPARE(negativeDist.getMin(), 0.0);
+    QCOMPARE(negativeDist.getMax(), 0.0);
+
+    negativeDist.addSample(-5.0);
+    negativeDist.addSample(-2.0);
+    QCOMPARE(negativeDist.getMin(), -5.0);
+    QCOMPARE(negativeDist.getMax(), -2.0);
+
+    // Quantiles of an exponential distribution with unit rate, Q(p) = -ln(1-p), from the stored samples and from the sketch
+    std::exponential_distribution<double> exponentialDist(1.0);
+
+    REmpiricalProbabilityDistribution exactDist;
+    REmpiricalProbabilityDistribution sketchDist;
+    sketchDist.useQuantileSketch(100.0);
+
+    for(int i = 0; i<100000; ++i)
+    {
+        auto val = exponentialDist(generator);
+        exactDist.addSample(val);
+        sketchDist.addSample(val);
+    }
+
+    QCOMPARE(sketchDist.getNumberSamples(), 100000);
+    QVERIFY(std::fabs(sketchDist.mean() - exactDist.mean()) < 1.0e-12);
+
+    for(auto&& p : {0.01, 0.1, 0.5, 0.9, 0.99})
+    {
+        auto expected = -std::log(1.0-p);
+        auto tolerance = 0.05*std::max(expected, 1.0);
+
+        QVERIFY2(std::fabs(exactDist.quantile(p) - expected) < tolerance, qPrintable("Exact quantile at p = "+QString::number(p)));
+        QVERIFY2(std::fabs(sketchDist.quantile(p) - expected) < tolerance, qPrintable("Sketch quantile at p = "+QString::number(p)));
+    }
+
+    QCOMPARE(sketchDist.quantile(0.0), exactDist.getMin());
+    QCOMPARE(sketchDist.quantile(1.0), exactDist.getMax());
+
+    // The sketch is bounded by its compression
+    QVERIFY(sketchDist.getValues().size() <= 100);
+
+    // The histogram from the sketch has about the same bin counts as the one from the samples
+    auto exactHistogram = exactDist.updateHistogram();
+    auto sketchHistogram = sketchDist.updateHistogram();
+
+    for(int k = 1; k<exactHistogram.size(); ++k)
+        QVERIFY(std::fabs(exactHistogram.at(k) - sketchHistogram.at(k)) < 0.005*100000);
+}
+
+
+
+double R2DUnitTests::nextRandom(quint32& seed)
+{
+    seed = 1664525u*seed + 1013904223u;
+    return static_cast<double>(seed)/4294967296.0;
+}
+
+
+QStringList R2DUnitTests::parseLineCSVReference(const QString& csvString)
+{
+    QStringList fields;
+    QString value;
+
+    bool hasQuote = false;
+
+    for (int i = 0; i < csvString.size(); ++i)
+    {
+        const QChar current = csvString.at(i);
+
+        if (hasQuote == false)
+        {
+            if (current == ',')
+            {
+                fields.append(value.trimmed());
+                value.clear();
+            }
+            else if (current == '"')
+            {
+                hasQuote = true;
+                value += current;
+            }
+            else
+                value += current;
+        }
+        else
+        {
+            if (current == '"')
+            {
+                if (i+1 < csvString.size() && csvString.at(i+1) == '"')
+                {
+                    value += '"';
+                    i++;
+                }
+                else
+                {
+                    hasQuote = false;
+                    value += '"';
+                }
+            }
+            else
+                value += current;
+        }
+    }
+
+    if (!value.isEmpty())
+        fields.append(value.trimmed());
+
+    // Remove quotes and whitespace around quotes
+    for (int i=0; i<fields.size(); ++i)
+        if (fields[i].length()>=1 && fields[i].left(1)=='"')
+        {
+            fields[i]=fields[i].mid(1);
+            if (fields[i].length()>=1 && fields[i].right(1)=='"')
+                fields[i]=fields[i].left(fields[i].length()-1);
+        }
+
+    return fields;
+}
+
+
+
+void R2DUnitTests::testCSVReaderWriter()
+{
+    // Records with quoted newlines, escaped quotes, CRLF terminators, and empty fields
+    const QStringList recordTypes = {
+        "%1,plain,value\n",
+        "%1,\"quoted, with a comma\",x\r\n",
+        "%1,\"line one\nline two\",y\n",
+        "%1,\"she said \"\"hi\"\"\",z\r\n",
+        "%1,,\n",
+        "%1,\"crlf\r\ninside\",w\r\n"
+    };
+
+    // A long quoted record with many newlines is placed across each multiple of the 1 MB block size, so that it has to stay in one block
+    const int blockSize = 1 << 20;
+    QString longField;
+    for(int i = 0; i<200; ++i)
+        longField += QString("part %1, with a \"\"quote\"\"\n").arg(i);
+
+    QStringList records = {"id,name,comment\n"};
+    qint64 fileSize = records.first().size();
+    int nextBoundary = blockSize;
+
+    for(int id = 1; fileSize < 3*blockSize; ++id)
+    {
+        QString record;
+        if(fileSize > nextBoundary - longField.size()/2)
+        {
+            record = QString("%1,\"%2\",long\n").arg(id).arg(longField);
+            nextBoundary += blockSize;
+        }
+        else
+        {
+            record = recordTypes.at(id % recordTypes.size()).arg(id);
+        }
+
+        records.append(record);
+        fileSize += record.toUtf8().size();
+    }
+
+    // The last record does not have a terminating newline
+    records.append("last,\"no newline\",end");
+
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    auto csvPath = tempDir.filePath("records.csv");
+
+    QFile csvFile(csvPath);
+    QVERIFY(csvFile.open(QIODevice::WriteOnly));
+    csvFile.write(records.join(QString()).toUtf8());
+    csvFile.close();
+
+    QVector<QStringList> expected;
+    for(auto&& record : records)
+        expected.append(parseLineCSVReference(record));
+
+    CSVReaderWriter csvTool;
+    QString err;
+
+    auto rows = csvTool.parseCSVFile(csvPath, err);
+    QVERIFY2(err.isEmpty(), qPrintable(err));
+    QCOMPARE(rows.size(), expected.size());
+    QCOMPARE(rows, expected);
+
+    // The streaming parser hands over the same rows in the same order
+    QVector<QStringList> streamedRows;
+    auto res = csvTool.parseCSVFile(csvPath, [&streamedRows](int row, const QStringList& record)
+    {
+        if(row != streamedRows.size())
+            return false;
+
+        streamedRows.append(record);
+        return true;
+    }, err);
+
+    QCOMPARE(res, expected.size());
+    QCOMPARE(streamedRows, expected);
+
+    // Stopping the parse counts only the rows that were accepted
+    auto numAccepted = csvTool.parseCSVFile(csvPath, [](int row, const QStringList&)
+    {
+        return row < 3;
+    }, err);
+
+    QCOMPARE(numAccepted, 3);
+
+    // The rows of the file are the header followed by the records in the order of their ids
+    QCOMPARE(rows.at(2).at(1), QString("line one\nline two"));
+    QCOMPARE(rows.at(3).at(1), QString("she said \"hi\""));
+    QCOMPARE(rows.last(), QStringList({"last","no newline","end"}));
+}
+
+
+
+void R2DUnitTests::testColumnarTable()
+{
+    const QStringList header = {"id","zip","cost","ratio","sci","height"};
+
+    // Codes with leading zeros and decimals with trailing zeros would be changed by a numeric column, so those columns stay strings
+    const QVector<QStringList> rows = {
+        {"1","06037","1.50","0.25","1e3","10"},
+        {"2","94720","2.00","0.5","2e3","12.5"},
+        {"3","00501","3.25","","3e3","-7"},
+    };
+
+    auto table = ColumnarTable::fromStringRows(rows, header);
+
+    QCOMPARE(table.columnType(0), ColumnarTable::Int64Column);
+    QCOMPARE(table.columnType(1), ColumnarTable::StringColumn);
+    QCOMPARE(table.columnType(2), ColumnarTable::StringColumn);
+    QCOMPARE(table.columnType(3), ColumnarTable::DoubleColumn);
+    QCOMPARE(table.columnType(4), ColumnarTable::StringColumn);
+    QCOMPARE(table.columnType(5), ColumnarTable::DoubleColumn);
+
+    QVERIFY(table.isNull(2,3));
+    QCOMPARE(table.doubleValue(0,2), 1.5);
+    QCOMPARE(table.toStringRows(), rows);
+
+    // Setting a value that does not round trip widens the column and keeps the existing text
+    QVERIFY(table.setValue(1,5,"12.50"));
+    QCOMPARE(table.columnType(5), ColumnarTable::StringColumn);
+    QCOMPARE(table.rowStrings(0).at(5), QString("10"));
+    QCOMPARE(table.rowStrings(1).at(5), QString("12.50"));
+
+    // Integers that would be written differently as doubles, or lose digits, keep the column from being widened to doubles
+    const QVector<QStringList> intRows = {
+        {"1","10000000","9007199254740993"},
+        {"2","2.5","2.5"},
+    };
+
+    auto intTable = ColumnarTable::fromStringRows(intRows, {"id","count","big"});
+
+    QCOMPARE(intTable.columnType(0), ColumnarTable::Int64Column);
+    QCOMPARE(intTable.columnType(1), ColumnarTable::StringColumn);
+    QCOMPARE(intTable.columnType(2), ColumnarTable::StringColumn);
+    QCOMPARE(intTable.toStringRows(), intRows);
+
+    // Integers that are exact as doubles are widened to doubles
+    auto smallIntTable = ColumnarTable::fromStringRows({{"12"},{"2.5"}}, {"value"});
+    QCOMPARE(smallIntTable.columnType(0), ColumnarTable::DoubleColumn);
+    QCOMPARE(smallIntTable.toStringRows(), QVector<QStringList>({{"12"},{"2.5"}}));
+
+    // The inventory file that is written for the backend has the same text as the input file
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    auto inPath = tempDir.filePath("inventory.csv");
+    auto outPath = tempDir.filePath("inventory_out.csv");
+
+    QFile inFile(inPath);
+    QVERIFY(inFile.open(QIODevice::WriteOnly));
+    inFile.write("id,zip,cost,ratio,sci,height\n1,06037,1.50,0.25,1e3,10\n2,94720,2.00,0.5,2e3,12.5\n3,00501,3.25,,3e3,-7\n");
+    inFile.close();
+
+    CSVReaderWriter csvTool;
+    QString err;
+
+    auto inventory = csvTool.parseCSVFileToTable(inPath, err);
+    QVERIFY2(err.isEmpty(), qPrintable(err));
+    QCOMPARE(csvTool.saveCSVFile(inventory, outPath, err), 0);
+
+    QFile outFile(outPath);
+    QVERIFY(outFile.open(QIODevice::ReadOnly));
+    QCOMPARE(outFile.readAll(), QByteArray("id,zip,cost,ratio,sci,height\n1,06037,1.50,0.25,1e3,10\n2,94720,2.00,0.5,2e3,12.5\n3,00501,3.25,,3e3,-7\n"));
+}
+
+
+void R2DUnitTests::testComponentTableModel()
+{
+    const QStringList header = {"ID","Latitude","Longitude"};
+    const QVector<QStringList> rows = {{"1","37.8712345678","-122.2712345"},{"2","37.9","-122.3"}};
+
+    ComponentTableModel model;
+    model.populateData(rows, header);
+
+    QSignalSpy changedSpy(&model, &ComponentTableModel::handleCellChanged);
+
+    // Committing the editor without changing it leaves the text of every cell as it was
+    for(int i = 0; i<rows.size(); ++i)
+    {
+        for(int j = 0; j<header.size(); ++j)
+        {
+            auto index = model.index(i,j);
+            QVERIFY(model.setData(index, model.data(index, Qt::EditRole), Qt::EditRole));
+        }
+    }
+
+    QCOMPARE(model.getTableData(), rows);
+    QCOMPARE(changedSpy.count(), 0);
+
+    // A typed double keeps all of its digits
+    auto latIndex = model.index(1,1);
+    QVERIFY(model.setData(latIndex, QVariant(37.8712345678), Qt::EditRole));
+    QCOMPARE(model.data(latIndex, Qt::EditRole).toString(), QString("37.8712345678"));
+    QCOMPARE(model.getTable().value(1,1).toDouble(), 37.8712345678);
+    QCOMPARE(changedSpy.count(), 1);
+}
+
+
+void R2DUnitTests::testEventGridFile()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    const QStringList IMNames = {"PGA","SA_1.0"};
+
+    // The default layout is the grid file and site files that the backend reads
+    auto legacyPath = tempDir.filePath("EventGrid.csv");
+
+    EventGridFile gridFile;
+    QString err;
+
+    QCOMPARE(gridFile.open(legacyPath, IMNames, err), 0);
+    QCOMPARE(gridFile.addSite(37.87, -122.27, {"0.31","0.12"}), 0);
+    gridFile.addRealization({"0.35","0.14"});
+    QCOMPARE(gridFile.addSite(37.9, -122.3, {"0.28","0.1"}), 1);
+    QCOMPARE(gridFile.close(err), 0);
+
+    QFile legacyFile(legacyPath);
+    QVERIFY(legacyFile.open(QIODevice::ReadOnly));
+    QCOMPARE(legacyFile.readAll(), QByteArray("GP_file,Latitude,Longitude\nSite_0.csv,37.87,-122.27\nSite_1.csv,37.9,-122.3\n"));
+
+    QFile siteFile(tempDir.filePath("Site_0.csv"));
+    QVERIFY(siteFile.open(QIODevice::ReadOnly));
+    QCOMPARE(siteFile.readAll(), QByteArray("PGA,SA_1.0\n0.31,0.12\n0.35,0.14\n"));
+
+    QStringList readIMNames;
+    QVector<EventGridSite> sites;
+
+    QCOMPARE(gridFile.read(legacyPath, readIMNames, sites, err), 2);
+    QCOMPARE(readIMNames, IMNames);
+    QCOMPARE(sites.at(0).name, QString("Site_0"));
+    QCOMPARE(sites.at(0).latitude, 37.87);
+    QCOMPARE(sites.at(0).realizations, QVector<QVector<double>>({{0.31,0.12},{0.35,0.14}}));
+    QCOMPARE(sites.at(1).realizations, QVector<QVector<double>>({{0.28,0.1}}));
+
+    // A grid without the site file column is rejected
+    QFile badFile(tempDir.filePath("BadGrid.csv"));
+    QVERIFY(badFile.open(QIODevice::WriteOnly));
+    badFile.write("Site,Latitude,Longitude,PGA\n0,37.87,-122.27,0.31\n");
+    badFile.close();
+
+    err.clear();
+    QCOMPARE(gridFile.read(badFile.fileName(), readIMNames, sites, err), -1);
+    QVERIFY(!err.isEmpty());
+}
+
+
+void R2DUnitTests::testEventGridHdf5File()
+{
+    if(!EventGridHdf5File::isAvailable())
+        QSKIP("This build does not include HDF5 support");
+
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    const QStringList IMNames = {"PGA","SA_1.0"};
+    const QVector<double> latitudes = {37.87, 37.9, 37.95};
+    const QVector<double> longitudes = {-122.27, -122.3, -122.35};
+
+    // Two events, three sites and two intensity measures in the events x sites x IMs order
+    QVector<double> values;
+    for(int i = 0; i<2*3*2; ++i)
+        values.append(0.01*(i+1));
+
+    auto path = tempDir.filePath("EventGrid.h5");
+
+    EventGridHdf5File gridFile;
+
+    // Chunks smaller than the number of sites, so that the dataset is written in more than one chunk
+    gridFile.setChunkSites(2);
+
+    QString err;
+    QCOMPARE(gridFile.write(path, IMNames, latitudes, longitudes, values, 2, err), 0);
+    QVERIFY(err.isEmpty());
+
+    // The number of values has to match the events, sites and IMs
+    QCOMPARE(gridFile.write(tempDir.filePath("Bad.h5"), IMNames, latitudes, longitudes, values, 3, err), -1);
+    QVERIFY(!err.isEmpty());
+
+#ifdef INCLUDE_HDF5
+    auto file = H5Fopen(path.toLocal8Bit().constData(), H5F_ACC_RDONLY, H5P_DEFAULT);
+    QVERIFY(file >= 0);
+
+    auto dataset = H5Dopen2(file, "IntensityMeasures", H5P_DEFAULT);
+    QVERIFY(dataset >= 0);
+
+    auto space = H5Dget_space(dataset);
+    hsize_t dims[3] = {0, 0, 0};
+    QCOMPARE(H5Sget_simple_extent_ndims(space), 3);
+    H5Sget_simple_extent_dims(space, dims, nullptr);
+    QCOMPARE(dims[0], hsize_t(2));
+    QCOMPARE(dims[1], hsize_t(3));
+    QCOMPARE(dims[2], hsize_t(2));
+
+    QVector<double> readValues(values.size());
+    QVERIFY(H5Dread(dataset, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, readValues.data()) >= 0);
+    QCOMPARE(readValues, values);
+
+    H5Sclose(space);
+    H5Dclose(dataset);
+
+    auto latDataset = H5Dopen2(file, "Latitude", H5P_DEFAULT);
+    QVERIFY(latDataset >= 0);
+
+    QVector<double> readLatitudes(latitudes.size());
+    QVERIFY(H5Dread(latDataset, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, readLatitudes.data()) >= 0);
+    QCOMPARE(readLatitudes, latitudes);
+
+    H5Dclose(latDataset);
+    H5Fclose(file);
+#endif
+}
+
+
+void R2DUnitTests::testProcessRunner()
+{
+#ifdef Q_OS_WIN
+    QSKIP("The fake backend is a shell script");
+#endif
+
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    // A fake backend that reports its progress, writes to both streams, and ends without a newline
+    auto scriptPath = tempDir.filePath("fakeBackend.sh");
+
+    QFile scriptFile(scriptPath);
+    QVERIFY(scriptFile.open(QIODevice::WriteOnly));
+    scriptFile.write("echo 'PROGRESS: 25% Simulating site 1 of 4'\n"
+                     "echo 'a warning' 1>&2\n"
+                     "echo 'PROGRESS: 50.5%'\n"
+                     "printf 'done'\n"
+                     "exit 3\n");
+    scriptFile.close();
+
+    qRegisterMetaType<QProcess::ExitStatus>("QProcess::ExitStatus");
+
+    ProcessRunner runner;
+
+    QSignalSpy startedSpy(&runner, &ProcessRunner::started);
+    QSignalSpy progressSpy(&runner, &ProcessRunner::progress);
+    QSignalSpy outputSpy(&runner, &ProcessRunner::outputLine);
+    QSignalSpy errorSpy(&runner, &ProcessRunner::errorLine);
+    QSignalSpy finishedSpy(&runner, &ProcessRunner::finished);
+    QSignalSpy failedSpy(&runner, &ProcessRunner::failedToStart);
+
+    QVERIFY(runner.start("/bin/sh", {scriptPath}));
+    QVERIFY(finishedSpy.wait(10000));
+
+    QCOMPARE(startedSpy.count(), 1);
+
+    QCOMPARE(progressSpy.count(), 2);
+    QCOMPARE(progressSpy.at(0).at(0).toDouble(), 25.0);
+    QCOMPARE(progressSpy.at(0).at(1).toString(), QString("Simulating site 1 of 4"));
+    QCOMPARE(progressSpy.at(1).at(0).toDouble(), 50.5);
+
+    // The progress lines are not repeated as output
+    QCOMPARE(outputSpy.count(), 1);
+    QCOMPARE(outputSpy.last().at(0).toString(), QString("done"));
+    QCOMPARE(errorSpy.count(), 1);
+    QCOMPARE(errorSpy.at(0).at(0).toString(), QString("a warning"));
+
+    QCOMPARE(finishedSpy.count(), 1);
+    QCOMPARE(finishedSpy.at(0).at(0).toInt(), 3);
+    QCOMPARE(finishedSpy.at(0).at(1).value<QProcess::ExitStatus>(), QProcess::NormalExit);
+    QVERIFY(!runner.wasCancelled());
+    QCOMPARE(failedSpy.count(), 0);
+
+    // A cancelled run finishes once the process has been terminated
+    auto longScriptPath = tempDir.filePath("longBackend.sh");
+
+    QFile longScriptFile(longScriptPath);
+    QVERIFY(longScriptFile.open(QIODevice::WriteOnly));
+    longScriptFile.write("echo 'PROGRESS: 10%'\n"
+                         "exec sleep 30\n");
+    longScriptFile.close();
+
+    progressSpy.clear();
+    finishedSpy.clear();
+
+    runner.setTerminateTimeout(1000);
+
+    QVERIFY(runner.start("/bin/sh", {longScriptPath}));
+    QVERIFY(progressSpy.wait(10000));
+    QVERIFY(runner.isRunning());
+
+    // Only one run at a time
+    QVERIFY(!runner.start("/bin/sh", {scriptPath}));
+
+    runner.cancel();
+
+    QVERIFY(finishedSpy.wait(10000));
+    QCOMPARE(finishedSpy.count(), 1);
+    QVERIFY(runner.wasCancelled());
+    QVERIFY(!runner.isRunning());
+
+    // A program that cannot be started is only reported once
+    QVERIFY(runner.start(tempDir.filePath("doesNotExist"), {}));
+    QTRY_COMPARE(failedSpy.count(), 1);
+    QTest::qWait(100);
+    QCOMPARE(finishedSpy.count(), 1);
+}
+
+
+void R2DUnitTests::testResultsAggregator()
+{
+    // A results table as it is loaded for one asset type, the id column is not a result
+    const QStringList header = {"AIM_id","RepairCost","RepairTime"};
+
+    ColumnarTable table;
+    table.setHeader(header, {ColumnarTable::Int64Column, ColumnarTable::DoubleColumn, ColumnarTable::DoubleColumn});
+
+    const QVector<QVector<double>> results = {{100.0, 5.0}, {250.0, 12.0}, {50.0, 2.0}, {400.0, 30.0}};
+
+    ResultsAggregator aggregator;
+    aggregator.addGroup("Buildings", {"RepairCost","RepairTime"});
+
+    for(int i = 0; i<results.size(); ++i)
+    {
+        table.appendRow(QVector<QVariant>({QString::number(i+1), results.at(i).at(0), results.at(i).at(1)}));
+        aggregator.addRow("Buildings", results.at(i));
+    }
+
+    auto cost = aggregator.getAggregate("Buildings","RepairCost");
+    QCOMPARE(cost.count, qint64(4));
+    QCOMPARE(cost.total, 800.0);
+    QCOMPARE(cost.mean(), 200.0);
+    QCOMPARE(cost.min, 50.0);
+    QCOMPARE(cost.max, 400.0);
+
+    // The id column is never aggregated
+    QCOMPARE(aggregator.getAggregate("AIM_id").count, qint64(0));
+
+    // Recomputing from the table gives the same aggregates under the same column names
+    QString err;
+    QCOMPARE(aggregator.addTable("Buildings", table, err), 0);
+    QCOMPARE(aggregator.getColumns("Buildings"), QStringList({"RepairCost","RepairTime"}));
+    QCOMPARE(aggregator.getAggregate("RepairCost").total, 800.0);
+    QCOMPARE(aggregator.getAggregate("RepairTime").total, 49.0);
+    QCOMPARE(aggregator.getAggregate("AIM_id").count, qint64(0));
+
+    // A subset of the assets
+    QCOMPARE(aggregator.addTable("Buildings", table, err, {1, 3}), 0);
+    QCOMPARE(aggregator.getAggregate("RepairCost").count, qint64(2));
+    QCOMPARE(aggregator.getAggregate("RepairCost").total, 650.0);
+    QCOMPARE(aggregator.getAggregate("RepairTime").min, 12.0);
+
+    QCOMPARE(ResultsAggregator::getQuantile(table, "RepairCost", 0.5, err), 175.0);
+    QCOMPARE(ResultsAggregator::getQuantile(table, "RepairTime", 0.5, err, {1, 3}), 21.0);
+    QVERIFY(err.isEmpty());
+
+    // The groups are kept apart and merged over all of the groups
+    aggregator.addGroup("Pipes", {"RepairCost"});
+    aggregator.addRow("Pipes", {10.0});
+    QCOMPARE(aggregator.getAggregate("RepairCost").total, 660.0);
+    QCOMPARE(aggregator.getGroups(), QStringList({"Buildings","Pipes"}));
+
+    // A table without the columns of the group, or a group that was not added, is an error
+    QVERIFY(aggregator.addTable("Roads", table, err) != 0);
+    QVERIFY(!err.isEmpty());
+    err.clear();
+
+    aggregator.addGroup("Bridges", {"DamageRatio"});
+    QVERIFY(aggregator.addTable("Bridges", table, err) != 0);
+    QVERIFY(!err.isEmpty());
+}
+
+
+
 QTEST_MAIN(R2DUnitTests)
 #include "R2DUnitTests.moc"
@@ -58,7 +58,7 @@ AssetInputDelegate::AssetInputDelegate()
 
 int AssetInputDelegate::size()
 {
-    return selectedComponentIDs.size();
+    return static_cast<int>(selectedComponentIDs.size());
 }
 
 
@@ -146,9 +146,8 @@ void AssetInputDelegate::selectComponents()
                 continue;
             }
 
-            // Add the IDs to the set
-            for(int ID = IDStart; ID<=IDEnd; ++ID)
-                selectedComponentIDs.insert(ID);
+            // Add the IDs to the set as a single range
+            selectedComponentIDs.insertRange(IDStart, IDEnd);
         }
         else // Asset ID is given individually
         {
@@ -168,7 +167,7 @@ void AssetInputDelegate::selectComponents()
 }
 
 
-std::set<int> AssetInputDelegate::getSelectedComponentIDs() const
+const ComponentIDSet& AssetInputDelegate::getSelectedComponentIDs() const
 {
     return selectedComponentIDs;
 }
@@ -176,32 +175,6 @@ std::set<int> AssetInputDelegate::getSelectedComponentIDs() const
 
 QString AssetInputDelegate::getComponentAnalysisList()
 {
-    QString stringList;
-
-    std::set<int>::iterator it;
-    for (it = selectedComponentIDs.begin(); it != selectedComponentIDs.end(); ++it)
-    {
-        int first = *it;
-        int next = *it;
-        while(std::next(it, 1) != selectedComponentIDs.end() && *std::next(it, 1) == *it +1 )
-        {
-            next = *std::next(it, 1);
-            ++it;
-        }
-
-        if(next == first)
-        {
-            stringList.append(QString::number(*it)+",");
-        }
-        else
-        {
-            stringList.append(QString::number(first)+"-"+QString::number(next)+",");
-        }
-    }
-
-    // Remove the last comma
-    stringList.truncate(stringList.lastIndexOf(QChar(',')));
-
-    return stringList;
+    return selectedComponentIDs.toString();
 }
 
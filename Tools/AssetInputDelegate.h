@@ -38,9 +38,9 @@ UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 
 // Written by: Stevan Gavrilovic
 
-#include <QLineEdit>
+#include "ComponentIDSet.h"
 
-#include <set>
+#include <QLineEdit>
 
 class AssetInputDelegate : public QLineEdit
 {
@@ -49,7 +49,7 @@ class AssetInputDelegate : public QLineEdit
 public:
     AssetInputDelegate();
 
-    std::set<int> getSelectedComponentIDs() const;
+    const ComponentIDSet& getSelectedComponentIDs() const;
 
     void insertSelectedComponent(const int id);
 
@@ -70,7 +70,7 @@ signals:
 
 private:
 
-    std::set<int> selectedComponentIDs;
+    ComponentIDSet selectedComponentIDs;
 
     QString prevText;
 };
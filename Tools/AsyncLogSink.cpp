@@ -0,0 +1,197 @@
+/* *****************************************************************************
+Copyright (c) 2016-2021, The Regents of the University of California (Regents).
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those
+of the authors and should not be interpreted as representing official policies,
+either expressed or implied, of the FreeBSD Project.
+
+REGENTS SPECIFICALLY DISCLAIMS ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+THE SOFTWARE AND ACCOMPANYING DOCUMENTATION, IF ANY, PROVIDED HEREUNDER IS
+PROVIDED "AS IS". REGENTS HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+
+*************************************************************************** */
+
+
+#include "AsyncLogSink.h"
+
+#include <chrono>
+
+AsyncLogSink::AsyncLogSink(const QString& filePath, const qint64 maxFileSize) : logFilePath(filePath), maxSize(maxFileSize)
+{
+    // The queue always holds one dummy node, the tail, so that producers never touch the same node as the consumer
+    tail = new Node();
+    head.store(tail);
+
+    logFile.setFileName(logFilePath);
+    if(logFile.open(QIODevice::WriteOnly | QIODevice::Append))
+        currentSize = logFile.size();
+
+    running.store(true);
+    writerThread = std::thread(&AsyncLogSink::run, this);
+}
+
+
+AsyncLogSink::~AsyncLogSink()
+{
+    this->shutdown();
+
+    // Lines from threads that were still logging during the shutdown
+    {
+        std::lock_guard<std::mutex> lock(fileMutex);
+        this->drainQueue();
+        logFile.flush();
+    }
+
+    delete tail;
+}
+
+
+void AsyncLogSink::write(const QByteArray& line)
+{
+    if(!running.load())
+    {
+        std::lock_guard<std::mutex> lock(fileMutex);
+        this->appendToFile(line);
+        logFile.flush();
+        return;
+    }
+
+    auto node = new Node();
+    node->line = line;
+
+    auto prev = head.exchange(node, std::memory_order_acq_rel);
+    prev->next.store(node, std::memory_order_release);
+}
+
+
+void AsyncLogSink::writeSynchronously(const QByteArray& line)
+{
+    this->shutdown();
+
+    std::lock_guard<std::mutex> lock(fileMutex);
+    this->appendToFile(line);
+    logFile.flush();
+}
+
+
+void AsyncLogSink::shutdown(void)
+{
+    if(!running.exchange(false))
+        return;
+
+    stopping.store(true);
+
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        wakeCondition.notify_one();
+    }
+
+    if(writerThread.joinable() && writerThread.get_id() != std::this_thread::get_id())
+        writerThread.join();
+
+    // Lines pushed by other threads while the writer was stopping
+    std::lock_guard<std::mutex> lock(fileMutex);
+    this->drainQueue();
+    logFile.flush();
+}
+
+
+void AsyncLogSink::run(void)
+{
+    while(!stopping.load())
+    {
+        bool wroteLines = false;
+
+        {
+            std::lock_guard<std::mutex> lock(fileMutex);
+            wroteLines = this->drainQueue();
+
+            // The file buffer is flushed once per batch rather than once per line
+            if(wroteLines)
+                logFile.flush();
+        }
+
+        if(!wroteLines)
+        {
+            std::unique_lock<std::mutex> lock(wakeMutex);
+            wakeCondition.wait_for(lock, std::chrono::milliseconds(100), [this]{ return stopping.load(); });
+        }
+    }
+}
+
+
+bool AsyncLogSink::drainQueue(void)
+{
+    bool wroteLines = false;
+
+    auto next = tail->next.load(std::memory_order_acquire);
+
+    while(next != nullptr)
+    {
+        this->appendToFile(next->line);
+        wroteLines = true;
+
+        // The node that was read becomes the new dummy tail
+        delete tail;
+        tail = next;
+
+        next = tail->next.load(std::memory_order_acquire);
+    }
+
+    return wroteLines;
+}
+
+
+void AsyncLogSink::appendToFile(const QByteArray& line)
+{
+    this->rotateIfNeeded();
+
+    if(!logFile.isOpen())
+        return;
+
+    logFile.write(line);
+    logFile.write("\n", 1);
+
+    currentSize += line.size() + 1;
+}
+
+
+void AsyncLogSink::rotateIfNeeded(void)
+{
+    if(maxSize <= 0 || !logFile.isOpen() || currentSize < maxSize)
+        return;
+
+    logFile.close();
+
+    // Keep one previous log file
+    auto previousLogFilePath = logFilePath + ".1";
+    QFile::remove(previousLogFilePath);
+    QFile::rename(logFilePath, previousLogFilePath);
+
+    logFile.open(QIODevice::WriteOnly | QIODevice::Append);
+
+    currentSize = 0;
+}
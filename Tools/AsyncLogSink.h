@@ -0,0 +1,111 @@
+#ifndef ASYNCLOGSINK_H
+#define ASYNCLOGSINK_H
+/* *****************************************************************************
+Copyright (c) 2016-2021, The Regents of the University of California (Regents).
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those
+of the authors and should not be interpreted as representing official policies,
+either expressed or implied, of the FreeBSD Project.
+
+REGENTS SPECIFICALLY DISCLAIMS ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+THE SOFTWARE AND ACCOMPANYING DOCUMENTATION, IF ANY, PROVIDED HEREUNDER IS
+PROVIDED "AS IS". REGENTS HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+
+*************************************************************************** */
+
+
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+// Log file writer that moves the file I/O off of the threads that log
+//
+// Messages are pushed onto a lock-free multiple-producer single-consumer queue and a background thread appends them to the file in batches.
+// The file is rotated to <file>.1 once it grows past the maximum size. A fatal message can be written with writeSynchronously(), which first drains the queue so that nothing logged before it is lost.
+class AsyncLogSink
+{
+public:
+    AsyncLogSink(const QString& filePath, const qint64 maxFileSize = 10*1024*1024);
+    ~AsyncLogSink();
+
+    // Queues a line to be written, the newline is added by the sink. Safe to call from any thread
+    void write(const QByteArray& line);
+
+    // Writes everything that is queued and then the given line, and flushes the file before returning
+    void writeSynchronously(const QByteArray& line);
+
+    // Writes everything that is queued and stops the background thread
+    // Lines that are written after the shutdown are written synchronously, i.e., appended and flushed to the file on the calling thread before write() returns
+    void shutdown(void);
+
+private:
+
+    struct Node
+    {
+        QByteArray line;
+        std::atomic<Node*> next{nullptr};
+    };
+
+    void run(void);
+
+    // Moves the queued lines into the file buffer, only called by the thread that owns the file
+    bool drainQueue(void);
+
+    void appendToFile(const QByteArray& line);
+
+    void rotateIfNeeded(void);
+
+    QString logFilePath;
+    qint64 maxSize;
+
+    QFile logFile;
+
+    // Size of the file including what is still in its write buffer
+    qint64 currentSize = 0;
+
+    // The queue, producers exchange the head and the consumer follows the next pointers from the tail
+    std::atomic<Node*> head;
+    Node* tail;
+
+    std::atomic<bool> stopping{false};
+    std::atomic<bool> running{false};
+
+    // Only used to put the background thread to sleep when there is nothing to write
+    std::mutex wakeMutex;
+    std::condition_variable wakeCondition;
+
+    // Serializes the file when it is written synchronously after the thread has stopped
+    std::mutex fileMutex;
+
+    std::thread writerThread;
+};
+
+#endif // ASYNCLOGSINK_H
@@ -239,6 +239,7 @@ void CBCitiesPostProcessor::importResults(const QString& pathToResults)
     if(!errMsg.isEmpty())
         throw errMsg;
 
+    this->buildDVRowIndex();
 
     if(!DVdata.empty())
         this->processDVResults(DVdata);
@@ -485,7 +486,29 @@ int CBCitiesPostProcessor::createHistogramChart(REmpiricalProbabilityDistributio
 
 
 
-void CBCitiesPostProcessor::processResultsSubset(const std::set<int>& selectedComponentIDs)
+void CBCitiesPostProcessor::buildDVRowIndex(void)
+{
+    DVRowIndex.clear();
+    DVRowIndex.reserve(DVdata.size());
+
+    for(int i = numHeaderRows; i<DVdata.size(); ++i)
+    {
+        const auto& row = DVdata.at(i);
+
+        if(row.isEmpty())
+            continue;
+
+        bool OK = false;
+        auto assetID = row.at(0).toInt(&OK);
+
+        // If an id is repeated, the first row with that id is used
+        if(OK && !DVRowIndex.contains(assetID))
+            DVRowIndex.insert(assetID, i);
+    }
+}
+
+
+void CBCitiesPostProcessor::processResultsSubset(const ComponentIDSet& selectedComponentIDs)
 {
 
     if(selectedComponentIDs.empty())
@@ -508,6 +531,7 @@ void CBCitiesPostProcessor::processResultsSubset(const std::set<int>& selectedCo
     auto lastID = objectToInt(DVdata.last().at(0));
 
     QVector<QStringList> DVsubset(&DVdata[0],&DVdata[numHeaderRows]);
+    DVsubset.reserve(numHeaderRows + static_cast<int>(selectedComponentIDs.size()));
 
     for(auto&& id : selectedComponentIDs)
     {
@@ -518,26 +542,15 @@ void CBCitiesPostProcessor::processResultsSubset(const std::set<int>& selectedCo
             throw msg;
         }
 
-        auto found = false;
-        for(int i = numHeaderRows; i<DVdata.size(); ++i)
-        {
-            auto inputRow = DVdata.at(i);
-
-            auto buildingID = objectToInt(inputRow.at(0));
+        auto row = DVRowIndex.value(id, -1);
 
-            if(id == buildingID)
-            {
-                DVsubset << inputRow;
-                found = true;
-                break;
-            }
-        }
-
-        if(!found)
+        if(row == -1)
         {
             QString msg = "ID " + QString::number(id) + " cannot be found in the results";
             throw msg;
         }
+
+        DVsubset << DVdata.at(row);
     }
 
     this->processDVResults(DVsubset);
@@ -572,6 +585,7 @@ void CBCitiesPostProcessor::setCurrentlyViewable(bool status){
 void CBCitiesPostProcessor::clear(void)
 {
     DVdata.clear();
+    DVRowIndex.clear();
 
     outputFilePath.clear();
 
@@ -37,11 +37,43 @@ UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 // Written by: Stevan Gavrilovic
 
 #include "CSVReaderWriter.h"
+#include "ColumnarTable.h"
 
 #include <QVector>
 #include <QTextStream>
 #include <QStringList>
 #include <QFile>
+#include <QThread>
+#include <QtConcurrent/QtConcurrent>
+
+#include <string>
+
+namespace {
+
+// Target size in bytes of the blocks of records that are handed to the worker threads
+const qint64 csvBlockSize = 1 << 20;
+
+
+// Memory maps the file if possible, otherwise falls back to reading the file into the buffer
+const char* mapFileContents(QFile& file, QByteArray& fallbackBuffer, qint64& size)
+{
+    size = file.size();
+
+    if(size <= 0)
+        return nullptr;
+
+    auto mapped = file.map(0, size);
+
+    if(mapped != nullptr)
+        return reinterpret_cast<const char*>(mapped);
+
+    fallbackBuffer = file.readAll();
+    size = fallbackBuffer.size();
+
+    return fallbackBuffer.constData();
+}
+
+}
 
 CSVReaderWriter::CSVReaderWriter()
 {
@@ -87,39 +119,73 @@ int CSVReaderWriter::saveCSVFile(const QVector<QStringList>& data, const QString
 
     QTextStream csvFileOut(&file);
 
-    // Function to handle the case where there are commas within a cell
-    auto strOutput = [](const QString& in)
-    {
-        auto newStr = in;
+    for(auto&& row : data)
+        writeCSVRow(csvFileOut, row);
 
-        newStr = newStr.replace("\"","\"\"");
+    return 0;
+}
 
-        if(newStr.contains(','))
-            return "\"" + newStr.toUtf8() + "\"";
-        else
-         return newStr.toUtf8();
-    };
 
+int CSVReaderWriter::saveCSVFile(const ColumnarTable& table, const QString& pathToFile, QString& err)
+{
+    auto header = table.getHeader();
 
-    for(auto&& row : data)
+    if(header.isEmpty() || table.isEmpty())
     {
-        for(int i = 0; i<numCol; ++i)
-        {
-            csvFileOut<<strOutput(row[i]);
+        err = "Empty data table came into the function save data.";
+        return -1;
+    }
 
-            // Add the terminating character
-            if(i != numCol-1)
-                csvFileOut<<",";
-            else
-                csvFileOut<<"\n";
-        }
+    QFile file(pathToFile);
+
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        err = "Cannot create the file: " + pathToFile + "\n" +"Check your directory and try again.";
+        return -1;
     }
 
+    QTextStream csvFileOut(&file);
+
+    writeCSVRow(csvFileOut, header);
+
+    // Rows are converted to text one at a time
+    for(int i = 0; i<table.rowCount(); ++i)
+        writeCSVRow(csvFileOut, table.rowStrings(i));
 
     return 0;
 }
 
 
+QByteArray CSVReaderWriter::escapeCSVValue(const QString& in)
+{
+    auto newStr = in;
+
+    newStr = newStr.replace("\"","\"\"");
+
+    if(newStr.contains(','))
+        return "\"" + newStr.toUtf8() + "\"";
+    else
+        return newStr.toUtf8();
+}
+
+
+void CSVReaderWriter::writeCSVRow(QTextStream& out, const QStringList& row)
+{
+    auto numCol = row.size();
+
+    for(int i = 0; i<numCol; ++i)
+    {
+        out<<escapeCSVValue(row[i]);
+
+        // Add the terminating character
+        if(i != numCol-1)
+            out<<",";
+        else
+            out<<"\n";
+    }
+}
+
+
 QVector<QStringList> CSVReaderWriter::parseCSVFile(const QString &pathToFile, QString& err)
 {
     QVector<QStringList> returnVec;
@@ -132,44 +198,221 @@ QVector<QStringList> CSVReaderWriter::parseCSVFile(const QString &pathToFile, QS
         return returnVec;
     }
 
-    QStringList rowLines;
-    while (!geomFile.atEnd())
-    {
-        QString line = geomFile.readLine();
+    QByteArray fileBuffer;
+    qint64 fileSize = 0;
+    const char* data = mapFileContents(geomFile, fileBuffer, fileSize);
 
-        rowLines << line;
-    }
+    auto records = this->findRecordBoundaries(data, fileSize);
 
-    auto numRows = rowLines.size();
+    auto numRows = records.size();
     if(numRows == 0)
     {
         err = "Error in parsing the .csv file " + pathToFile + " in CVSReaderWriter::parseCSVFile";
         return returnVec;
     }
 
+    auto blocks = this->partitionRecords(records, fileSize);
+
+    QtConcurrent::blockingMap(blocks, [data](RecordBlock& block) {
+        block.rows = parseRecordBlock(data, block.records);
+    });
+
     returnVec.reserve(numRows);
 
-    for(auto&& it: rowLines)
+    for(auto&& block : blocks)
     {
-        auto lineStr = this->parseLineCSV(it);
-
-        returnVec.push_back(lineStr);
+        for(auto&& row : block.rows)
+            returnVec.push_back(std::move(row));
     }
 
     return returnVec;
 }
 
 
-QStringList CSVReaderWriter::parseLineCSV(const QString &csvString)
+int CSVReaderWriter::parseCSVFile(const QString &pathToFile, const RecordCallback& callback, QString& err)
+{
+    QFile geomFile(pathToFile);
+
+    if (!geomFile.open(QIODevice::ReadOnly))
+    {
+        err = "Cannot find the file: " + pathToFile + "\nCheck your directory and try again.";
+        return -1;
+    }
+
+    QByteArray fileBuffer;
+    qint64 fileSize = 0;
+    const char* data = mapFileContents(geomFile, fileBuffer, fileSize);
+
+    auto records = this->findRecordBoundaries(data, fileSize);
+
+    if(records.isEmpty())
+    {
+        err = "Error in parsing the .csv file " + pathToFile + " in CVSReaderWriter::parseCSVFile";
+        return -1;
+    }
+
+    auto blocks = this->partitionRecords(records, fileSize);
+
+    // Only a window of blocks is parsed at a time so that the parsed rows do not accumulate in memory
+    const int windowSize = qMax(1, 2*QThread::idealThreadCount());
+
+    int rowCount = 0;
+    for(int first = 0; first < blocks.size(); first += windowSize)
+    {
+        auto window = blocks.mid(first, windowSize);
+
+        QtConcurrent::blockingMap(window, [data](RecordBlock& block) {
+            block.rows = parseRecordBlock(data, block.records);
+        });
+
+        for(auto&& block : window)
+        {
+            for(auto&& row : block.rows)
+            {
+                // The row that the callback rejected is not counted
+                if(!callback(rowCount, row))
+                    return rowCount;
+
+                ++rowCount;
+            }
+        }
+    }
+
+    return rowCount;
+}
+
+
+ColumnarTable CSVReaderWriter::parseCSVFileToTable(const QString &pathToFile, QString& err)
+{
+    ColumnarTable table;
+
+    auto addRecord = [&table](int row, const QStringList& record)
+    {
+        if(row == 0)
+            table.setHeader(record);
+        else
+            table.appendRow(record);
+
+        return true;
+    };
+
+    auto res = this->parseCSVFile(pathToFile, addRecord, err);
+
+    if(res < 0)
+        table.clear();
+
+    return table;
+}
+
+
+QVector<CSVReaderWriter::RecordSpan> CSVReaderWriter::findRecordBoundaries(const char* data, qint64 size) const
+{
+    QVector<RecordSpan> records;
+
+    if(data == nullptr || size <= 0)
+        return records;
+
+    // Scan once over the raw bytes, keeping track of whether we are inside of a quoted field
+    // An escaped quote ("") toggles the state twice and hence leaves it unchanged
+    bool hasQuote = false;
+    qint64 recordStart = 0;
+
+    for(qint64 i = 0; i < size; ++i)
+    {
+        const char current = data[i];
+
+        if(current == '"')
+        {
+            hasQuote = !hasQuote;
+        }
+        else if(current == '\n' && !hasQuote)
+        {
+            records.push_back({recordStart, i + 1});
+            recordStart = i + 1;
+        }
+    }
+
+    // Last line without a terminating newline
+    if(recordStart < size)
+        records.push_back({recordStart, size});
+
+    return records;
+}
+
+
+QVector<CSVReaderWriter::RecordBlock> CSVReaderWriter::partitionRecords(const QVector<RecordSpan>& records, qint64 size) const
+{
+    QVector<RecordBlock> blocks;
+
+    if(records.isEmpty())
+        return blocks;
+
+    // Do not make more blocks than is useful, but make enough to keep all of the threads busy on large files
+    const qint64 blockSize = qMax(csvBlockSize, size / (64*qMax(1, QThread::idealThreadCount())));
+
+    blocks.reserve(static_cast<int>(size / blockSize) + 1);
+
+    RecordBlock currBlock;
+    qint64 blockStart = records.first().begin;
+
+    for(auto&& record : records)
+    {
+        currBlock.records.push_back(record);
+
+        if(record.end - blockStart >= blockSize)
+        {
+            blocks.push_back(std::move(currBlock));
+            currBlock = RecordBlock();
+            blockStart = record.end;
+        }
+    }
+
+    if(!currBlock.records.isEmpty())
+        blocks.push_back(std::move(currBlock));
+
+    return blocks;
+}
+
+
+QVector<QStringList> CSVReaderWriter::parseRecordBlock(const char* data, const QVector<RecordSpan>& block)
+{
+    QVector<QStringList> rows;
+    rows.reserve(block.size());
+
+    for(auto&& record : block)
+        rows.push_back(parseLineCSV(data + record.begin, data + record.end));
+
+    return rows;
+}
+
+
+QStringList CSVReaderWriter::parseLineCSV(const char* begin, const char* end)
 {
     QStringList fields;
-    QString value;
+
+    // The raw bytes of the field are collected here and decoded once the field is complete
+    std::string value;
+
+    // Removes whitespace and then the quotes that are around a field
+    auto addField = [&fields](const std::string& bytes)
+    {
+        auto field = QString::fromUtf8(bytes.data(), static_cast<int>(bytes.size())).trimmed();
+
+        if (field.startsWith('"'))
+        {
+            field.remove(0,1);
+            if (field.endsWith('"'))
+                field.chop(1);
+        }
+
+        fields.append(field);
+    };
 
     bool hasQuote = false;
 
-    for (int i = 0; i < csvString.size(); ++i)
+    for (const char* it = begin; it != end; ++it)
     {
-        const QChar current = csvString.at(i);
+        const char current = *it;
 
         // Normal state
         if (hasQuote == false)
@@ -178,7 +421,7 @@ QStringList CSVReaderWriter::parseLineCSV(const QString &csvString)
             if (current == ',')
             {
                 // Save field
-                fields.append(value.trimmed());
+                addField(value);
                 value.clear();
             }
 
@@ -193,26 +436,23 @@ QStringList CSVReaderWriter::parseLineCSV(const QString &csvString)
             else
                 value += current;
         }
-        else if (hasQuote)
+        else
         {
             // Check for another double-quote
             if (current == '"')
             {
-                if (i < csvString.size())
+                // A double double-quote?
+                if (it+1 != end && *(it+1) == '"')
                 {
-                    // A double double-quote?
-                    if (i+1 < csvString.size() && csvString.at(i+1) == '"')
-                    {
-                        value += '"';
-
-                        // Skip a second quote character in a row
-                        i++;
-                    }
-                    else
-                    {
-                        hasQuote = false;
-                        value += '"';
-                    }
+                    value += '"';
+
+                    // Skip a second quote character in a row
+                    ++it;
+                }
+                else
+                {
+                    hasQuote = false;
+                    value += '"';
                 }
             }
 
@@ -222,19 +462,8 @@ QStringList CSVReaderWriter::parseLineCSV(const QString &csvString)
         }
     }
 
-    if (!value.isEmpty())
-        fields.append(value.trimmed());
-
-
-    // Remove quotes and whitespace around quotes
-    for (int i=0; i<fields.size(); ++i)
-        if (fields[i].length()>=1 && fields[i].left(1)=='"')
-        {
-            fields[i]=fields[i].mid(1);
-            if (fields[i].length()>=1 && fields[i].right(1)=='"')
-                fields[i]=fields[i].left(fields[i].length()-1);
-        }
+    if (!value.empty())
+        addField(value);
 
     return fields;
 }
-
@@ -39,15 +39,22 @@ UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 // Written by: Stevan Gavrilovic
 
 #include <QVector>
+#include <QStringList>
+
+#include <functional>
 
 class QString;
-class QStringList;
+class QTextStream;
+class ColumnarTable;
 
 class CSVReaderWriter
 {
 public:
     CSVReaderWriter();
 
+    // Callback used by the streaming parser, it is given the row index and the parsed row. Return false to stop parsing.
+    using RecordCallback = std::function<bool(int row, const QStringList& record)>;
+
     // Saves data in the format of a CSV file
     int saveCSVFile(const QVector<QStringList>& data, const QString& pathToFile, QString& err);
 
@@ -56,9 +63,47 @@ public:
     // The string list corresponds to the items within a row, i.e., the values in the cells. There are as many items in the string list as there are in the row of the CSV file
     QVector<QStringList> parseCSVFile(const QString &pathToFile, QString& err);
 
+    // Streaming version of the parser above, the rows are handed to the callback in file order instead of being collected in a vector
+    // The parsing stops at the first row for which the callback returns false
+    // Returns the number of rows that the callback accepted, or -1 on error
+    int parseCSVFile(const QString &pathToFile, const RecordCallback& callback, QString& err);
+
+    // Parses a CSV file into a typed table, the first row of the file is taken as the header
+    ColumnarTable parseCSVFileToTable(const QString &pathToFile, QString& err);
+
+    // Saves a typed table in the format of a CSV file, with the table header as the first row
+    int saveCSVFile(const ColumnarTable& table, const QString& pathToFile, QString& err);
+
 private:
 
-    QStringList parseLineCSV(const QString &csvString);
+    // A record is the byte range [begin, end) of a row in the file, including its line terminator
+    struct RecordSpan
+    {
+        qint64 begin;
+        qint64 end;
+    };
+
+    // A contiguous block of records that is parsed by one worker thread
+    struct RecordBlock
+    {
+        QVector<RecordSpan> records;
+        QVector<QStringList> rows;
+    };
+
+    // Returns the spans of the records in the buffer, newlines inside quoted fields do not end a record
+    QVector<RecordSpan> findRecordBoundaries(const char* data, qint64 size) const;
+
+    // Splits the records into contiguous blocks of roughly equal byte size that are parsed on the worker pool
+    QVector<RecordBlock> partitionRecords(const QVector<RecordSpan>& records, qint64 size) const;
+
+    static QVector<QStringList> parseRecordBlock(const char* data, const QVector<RecordSpan>& block);
+
+    static QStringList parseLineCSV(const char* begin, const char* end);
+
+    // Quotes the value if it contains a comma, and escapes the quotes within it
+    static QByteArray escapeCSVValue(const QString& in);
+
+    static void writeCSVRow(QTextStream& out, const QStringList& row);
 
 };
 
@@ -0,0 +1,618 @@
+/* *****************************************************************************
+Copyright (c) 2016-2021, The Regents of the University of California (Regents).
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those
+of the authors and should not be interpreted as representing official policies,
+either expressed or implied, of the FreeBSD Project.
+
+REGENTS SPECIFICALLY DISCLAIMS ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+THE SOFTWARE AND ACCOMPANYING DOCUMENTATION, IF ANY, PROVIDED HEREUNDER IS
+PROVIDED "AS IS". REGENTS HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+
+*************************************************************************** */
+
+#include "ColumnarTable.h"
+
+#include <QLocale>
+
+namespace {
+
+// Dictionary encoding is switched off for a column once it is clear that most of its values are unique, e.g., footprints or IDs stored as text
+const int minDictionarySizeToCheck = 4096;
+
+
+// Returns true if the text is an integer written the way QString::number would write it, so that the text is recovered exactly from the stored value
+bool isCanonicalInteger(const QString& text)
+{
+    const int size = text.size();
+
+    int start = 0;
+    if(size > 0 && text.at(0) == '-')
+        start = 1;
+
+    if(start == size)
+        return false;
+
+    // No leading zeros, and no negative zero
+    if(text.at(start) == '0' && (size - start > 1 || start == 1))
+        return false;
+
+    for(int i = start; i < size; ++i)
+    {
+        auto c = text.at(i).unicode();
+        if(c < '0' || c > '9')
+            return false;
+    }
+
+    return true;
+}
+
+
+// Returns true if the text is a number written the way QString::number would write a double, so that the text is recovered exactly from the stored value
+// Text such as "1.50" or "1e3" is a valid number, but writing it back would change it, so it is not stored as a double
+bool isCanonicalDouble(const QString& text, double& val)
+{
+    bool ok = false;
+    val = text.toDouble(&ok);
+
+    if(!ok)
+        return false;
+
+    return QString::number(val, 'g', QLocale::FloatingPointShortest) == text;
+}
+
+
+// Returns true if the integer is written back as the same text once it is stored as a double, e.g., 10000000 would be written as 1e+07
+bool isExactAsDouble(const qint64 val)
+{
+    return QString::number(static_cast<double>(val), 'g', QLocale::FloatingPointShortest) == QString::number(val);
+}
+
+}
+
+
+ColumnarTable::ColumnarTable()
+{
+    numRows = 0;
+}
+
+
+ColumnarTable ColumnarTable::fromStringRows(const QVector<QStringList>& rows, const QStringList& header)
+{
+    ColumnarTable table;
+
+    table.setHeader(header);
+    table.reserve(rows.size());
+
+    for(auto&& row : rows)
+        table.appendRow(row);
+
+    return table;
+}
+
+
+ColumnarTable::ColumnType ColumnarTable::columnTypeFor(QVariant::Type type)
+{
+    switch(type)
+    {
+    case QVariant::Int:
+    case QVariant::UInt:
+    case QVariant::LongLong:
+    case QVariant::ULongLong:
+        return Int64Column;
+    case QVariant::Double:
+        return DoubleColumn;
+    default:
+        return StringColumn;
+    }
+}
+
+
+void ColumnarTable::setHeader(const QStringList& header, const QVector<ColumnType>& types)
+{
+    this->clear();
+
+    headerStringList = header;
+
+    columns.resize(header.size());
+
+    if(types.size() == header.size())
+    {
+        for(int i = 0; i<types.size(); ++i)
+            columns[i].type = types.at(i);
+    }
+}
+
+
+void ColumnarTable::reserve(int rows)
+{
+    for(auto&& column : columns)
+    {
+        if(column.type == Int64Column)
+            column.ints.reserve(rows);
+        else if(column.type == DoubleColumn)
+            column.doubles.reserve(rows);
+        else
+            column.codes.reserve(rows);
+
+        column.nullBits.reserve((rows + 31)/32);
+    }
+}
+
+
+void ColumnarTable::appendRow(const QStringList& row)
+{
+    const int numValues = row.size();
+
+    for(int i = 0; i<columns.size(); ++i)
+    {
+        auto& column = columns[i];
+
+        resizeColumn(column, numRows + 1);
+
+        if(i < numValues)
+            setText(column, numRows, row.at(i));
+        else
+            setNull(column, numRows, true);
+    }
+
+    ++numRows;
+}
+
+
+void ColumnarTable::appendRow(const QVector<QVariant>& row)
+{
+    const int numValues = row.size();
+
+    for(int i = 0; i<columns.size(); ++i)
+    {
+        auto& column = columns[i];
+
+        resizeColumn(column, numRows + 1);
+
+        if(i < numValues)
+            setVariant(column, numRows, row.at(i));
+        else
+            setNull(column, numRows, true);
+    }
+
+    ++numRows;
+}
+
+
+void ColumnarTable::clear(void)
+{
+    headerStringList.clear();
+    columns.clear();
+    numRows = 0;
+}
+
+
+bool ColumnarTable::isEmpty(void) const
+{
+    return numRows == 0;
+}
+
+
+int ColumnarTable::rowCount(void) const
+{
+    return numRows;
+}
+
+
+int ColumnarTable::columnCount(void) const
+{
+    return columns.size();
+}
+
+
+QStringList ColumnarTable::getHeader(void) const
+{
+    return headerStringList;
+}
+
+
+int ColumnarTable::columnIndex(const QString& name) const
+{
+    return headerStringList.indexOf(name);
+}
+
+
+ColumnarTable::ColumnType ColumnarTable::columnType(const int col) const
+{
+    return columns.at(col).type;
+}
+
+
+bool ColumnarTable::isNull(const int row, const int col) const
+{
+    if(col >= columns.size() || row >= numRows || row < 0 || col < 0)
+        return true;
+
+    return isNull(columns.at(col), row);
+}
+
+
+bool ColumnarTable::isRowNull(const int row) const
+{
+    for(int col = 0; col<columns.size(); ++col)
+    {
+        if(!this->isNull(row, col))
+            return false;
+    }
+
+    return true;
+}
+
+
+QVariant ColumnarTable::value(const int row, const int col) const
+{
+    if(this->isNull(row, col))
+        return QVariant();
+
+    const auto& column = columns.at(col);
+
+    if(column.type == Int64Column)
+        return QVariant(column.ints.at(row));
+    else if(column.type == DoubleColumn)
+        return QVariant(column.doubles.at(row));
+
+    return QVariant(column.dictionary.at(column.codes.at(row)));
+}
+
+
+QString ColumnarTable::stringValue(const int row, const int col) const
+{
+    if(this->isNull(row, col))
+        return QString();
+
+    return cellToString(columns.at(col), row);
+}
+
+
+double ColumnarTable::doubleValue(const int row, const int col, bool* ok) const
+{
+    if(this->isNull(row, col))
+    {
+        if(ok)
+            *ok = false;
+
+        return 0.0;
+    }
+
+    const auto& column = columns.at(col);
+
+    if(column.type == StringColumn)
+        return column.dictionary.at(column.codes.at(row)).toDouble(ok);
+
+    if(ok)
+        *ok = true;
+
+    if(column.type == Int64Column)
+        return static_cast<double>(column.ints.at(row));
+
+    return column.doubles.at(row);
+}
+
+
+qint64 ColumnarTable::int64Value(const int row, const int col, bool* ok) const
+{
+    if(this->isNull(row, col))
+    {
+        if(ok)
+            *ok = false;
+
+        return 0;
+    }
+
+    const auto& column = columns.at(col);
+
+    if(column.type == StringColumn)
+        return column.dictionary.at(column.codes.at(row)).toLongLong(ok);
+
+    if(ok)
+        *ok = true;
+
+    if(column.type == DoubleColumn)
+        return static_cast<qint64>(column.doubles.at(row));
+
+    return column.ints.at(row);
+}
+
+
+bool ColumnarTable::setValue(const int row, const int col, const QVariant& value)
+{
+    if(col >= columns.size() || row >= numRows || row < 0 || col < 0)
+        return false;
+
+    setVariant(columns[col], row, value);
+
+    return true;
+}
+
+
+QStringList ColumnarTable::rowStrings(const int row) const
+{
+    QStringList rowList;
+
+    if(row < 0 || row >= numRows)
+        return rowList;
+
+    rowList.reserve(columns.size());
+
+    for(auto&& column : columns)
+        rowList.append(isNull(column, row) ? QString() : cellToString(column, row));
+
+    return rowList;
+}
+
+
+QVector<QStringList> ColumnarTable::toStringRows(void) const
+{
+    QVector<QStringList> rows;
+    rows.reserve(numRows);
+
+    for(int i = 0; i<numRows; ++i)
+        rows.push_back(this->rowStrings(i));
+
+    return rows;
+}
+
+
+void ColumnarTable::resizeColumn(Column& column, const int rows)
+{
+    if(column.type == Int64Column)
+        column.ints.resize(rows);
+    else if(column.type == DoubleColumn)
+        column.doubles.resize(rows);
+    else
+        column.codes.resize(rows);
+
+    column.nullBits.resize((rows + 31)/32);
+}
+
+
+void ColumnarTable::setNull(Column& column, const int row, const bool null)
+{
+    auto& word = column.nullBits[row/32];
+    const quint32 mask = 1u << (row%32);
+
+    if(null)
+        word |= mask;
+    else
+        word &= ~mask;
+}
+
+
+bool ColumnarTable::isNull(const Column& column, const int row)
+{
+    return (column.nullBits.at(row/32) >> (row%32)) & 1u;
+}
+
+
+void ColumnarTable::setText(Column& column, const int row, const QString& text)
+{
+    if(text.isEmpty())
+    {
+        setNull(column, row, true);
+        return;
+    }
+
+    setNull(column, row, false);
+
+    if(column.type == Int64Column)
+    {
+        if(isCanonicalInteger(text))
+        {
+            bool ok = false;
+            auto val = text.toLongLong(&ok);
+
+            if(ok)
+            {
+                column.ints[row] = val;
+                return;
+            }
+        }
+
+        double val = 0.0;
+
+        // The column only becomes a double column if its integers are still written the same way as doubles, otherwise it becomes a string column
+        if(isCanonicalDouble(text, val))
+            promoteColumn(column, DoubleColumn);
+
+        if(column.type == DoubleColumn)
+        {
+            column.doubles[row] = val;
+            return;
+        }
+
+        promoteColumn(column, StringColumn);
+    }
+    else if(column.type == DoubleColumn)
+    {
+        double val = 0.0;
+
+        if(isCanonicalDouble(text, val))
+        {
+            column.doubles[row] = val;
+            return;
+        }
+
+        promoteColumn(column, StringColumn);
+    }
+
+    setString(column, row, text);
+}
+
+
+void ColumnarTable::setVariant(Column& column, const int row, const QVariant& value)
+{
+    if(!value.isValid() || value.isNull())
+    {
+        setNull(column, row, true);
+        return;
+    }
+
+    switch(value.type())
+    {
+    case QVariant::Int:
+    case QVariant::UInt:
+    case QVariant::LongLong:
+    case QVariant::ULongLong:
+    {
+        setNull(column, row, false);
+
+        auto val = value.toLongLong();
+
+        if(column.type == DoubleColumn && !isExactAsDouble(val))
+            promoteColumn(column, StringColumn);
+
+        if(column.type == Int64Column)
+            column.ints[row] = val;
+        else if(column.type == DoubleColumn)
+            column.doubles[row] = static_cast<double>(val);
+        else
+            setString(column, row, QString::number(val));
+
+        return;
+    }
+    case QVariant::Double:
+    {
+        setNull(column, row, false);
+
+        auto val = value.toDouble();
+
+        if(column.type == Int64Column)
+            promoteColumn(column, DoubleColumn);
+
+        if(column.type == DoubleColumn)
+            column.doubles[row] = val;
+        else
+            setString(column, row, QString::number(val, 'g', QLocale::FloatingPointShortest));
+
+        return;
+    }
+    default:
+        setText(column, row, value.toString());
+    }
+}
+
+
+void ColumnarTable::setString(Column& column, const int row, const QString& text)
+{
+    int code = -1;
+
+    if(column.deduplicate)
+    {
+        auto it = column.dictionaryIndex.constFind(text);
+
+        if(it != column.dictionaryIndex.constEnd())
+        {
+            code = it.value();
+        }
+        else
+        {
+            code = column.dictionary.size();
+            column.dictionary.append(text);
+            column.dictionaryIndex.insert(text, code);
+
+            // Most values are unique, the hash would only add overhead
+            if(code > minDictionarySizeToCheck && code > column.codes.size()/2)
+            {
+                column.deduplicate = false;
+                column.dictionaryIndex.clear();
+            }
+        }
+    }
+    else
+    {
+        code = column.dictionary.size();
+        column.dictionary.append(text);
+    }
+
+    column.codes[row] = code;
+}
+
+
+QString ColumnarTable::cellToString(const Column& column, const int row)
+{
+    if(column.type == Int64Column)
+        return QString::number(column.ints.at(row));
+    else if(column.type == DoubleColumn)
+        return QString::number(column.doubles.at(row), 'g', QLocale::FloatingPointShortest);
+
+    return column.dictionary.at(column.codes.at(row));
+}
+
+
+void ColumnarTable::promoteColumn(Column& column, const ColumnType type)
+{
+    if(type <= column.type)
+        return;
+
+    // An integer column is only widened to doubles if every integer is written back as the same text, otherwise it is widened to strings
+    auto intsAreExact = [&column](void) -> bool
+    {
+        for(int i = 0; i<column.ints.size(); ++i)
+        {
+            if(!isNull(column, i) && !isExactAsDouble(column.ints.at(i)))
+                return false;
+        }
+
+        return true;
+    };
+
+    if(column.type == Int64Column && type == DoubleColumn && intsAreExact())
+    {
+        const int rows = column.ints.size();
+
+        column.doubles.resize(rows);
+        for(int i = 0; i<rows; ++i)
+            column.doubles[i] = static_cast<double>(column.ints.at(i));
+
+        column.type = DoubleColumn;
+        column.ints = QVector<qint64>();
+
+        return;
+    }
+
+    // Widen to a string column, the numbers are written in the shortest form that reads back to the same value
+    const int rows = column.type == Int64Column ? column.ints.size() : column.doubles.size();
+
+    column.codes.resize(rows);
+
+    for(int i = 0; i<rows; ++i)
+    {
+        if(isNull(column, i))
+            continue;
+
+        setString(column, i, cellToString(column, i));
+    }
+
+    column.type = StringColumn;
+    column.ints = QVector<qint64>();
+    column.doubles = QVector<double>();
+}
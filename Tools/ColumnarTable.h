@@ -0,0 +1,146 @@
+#ifndef COLUMNARTABLE_H
+#define COLUMNARTABLE_H
+/* *****************************************************************************
+Copyright (c) 2016-2021, The Regents of the University of California (Regents).
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those
+of the authors and should not be interpreted as representing official policies,
+either expressed or implied, of the FreeBSD Project.
+
+REGENTS SPECIFICALLY DISCLAIMS ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+THE SOFTWARE AND ACCOMPANYING DOCUMENTATION, IF ANY, PROVIDED HEREUNDER IS
+PROVIDED "AS IS". REGENTS HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+
+*************************************************************************** */
+
+#include <QHash>
+#include <QStringList>
+#include <QVariant>
+#include <QVector>
+
+// Column oriented table of asset attributes
+// Every column is stored in a typed array (64-bit integers, doubles, or dictionary encoded strings) with a bitmap that flags the empty/null cells
+// Columns built from text have their type inferred from the values; a column is widened from integer to double to string as values that do not fit are encountered
+// A number is only stored in a numeric column if it is written back as the same text, e.g., "06037" and "1.50" stay strings
+// For the same reason an integer column whose integers would not be written back the same as doubles, e.g., 10000000 as 1e+07, is widened straight to strings
+class ColumnarTable
+{
+public:
+    enum ColumnType
+    {
+        Int64Column,
+        DoubleColumn,
+        StringColumn
+    };
+
+    ColumnarTable();
+
+    // Builds a table from rows of strings, as returned by the CSV reader, where the column types are inferred from the values
+    static ColumnarTable fromStringRows(const QVector<QStringList>& rows, const QStringList& header);
+
+    // Returns the column type that is used to store values of the given variant type
+    static ColumnType columnTypeFor(QVariant::Type type);
+
+    // Sets the header and creates empty columns. If no types are given, the column types are inferred from the values as they are appended
+    void setHeader(const QStringList& header, const QVector<ColumnType>& types = QVector<ColumnType>());
+
+    void reserve(int rows);
+
+    // Rows that are shorter than the header are padded with nulls, extra values are ignored
+    void appendRow(const QStringList& row);
+    void appendRow(const QVector<QVariant>& row);
+
+    void clear(void);
+
+    bool isEmpty(void) const;
+
+    int rowCount(void) const;
+    int columnCount(void) const;
+
+    QStringList getHeader(void) const;
+    int columnIndex(const QString& name) const;
+
+    ColumnType columnType(const int col) const;
+
+    bool isNull(const int row, const int col) const;
+
+    // Returns true if every cell of the row is null, i.e., the row was empty in the input
+    bool isRowNull(const int row) const;
+
+    // Returns the value with its native type, or an invalid variant if the cell is null or out of bounds
+    QVariant value(const int row, const int col) const;
+
+    QString stringValue(const int row, const int col) const;
+    double doubleValue(const int row, const int col, bool* ok = nullptr) const;
+    qint64 int64Value(const int row, const int col, bool* ok = nullptr) const;
+
+    // Sets the value of a cell, the column is widened if the value does not fit its type. An empty value sets the cell to null
+    bool setValue(const int row, const int col, const QVariant& value);
+
+    QStringList rowStrings(const int row) const;
+
+    // Converts the table back into rows of strings, excluding the header
+    QVector<QStringList> toStringRows(void) const;
+
+private:
+
+    struct Column
+    {
+        ColumnType type = Int64Column;
+
+        QVector<qint64> ints;
+        QVector<double> doubles;
+
+        // Dictionary encoding of string columns, the codes index into the dictionary
+        QVector<int> codes;
+        QStringList dictionary;
+        QHash<QString, int> dictionaryIndex;
+        bool deduplicate = true;
+
+        // One bit per row, set if the cell is null
+        QVector<quint32> nullBits;
+    };
+
+    static void resizeColumn(Column& column, const int rows);
+    static void setNull(Column& column, const int row, const bool null);
+    static bool isNull(const Column& column, const int row);
+
+    static void setText(Column& column, const int row, const QString& text);
+    static void setVariant(Column& column, const int row, const QVariant& value);
+    static void setString(Column& column, const int row, const QString& text);
+
+    static QString cellToString(const Column& column, const int row);
+
+    // Widens the column to the given type, converting the existing values
+    static void promoteColumn(Column& column, const ColumnType type);
+
+    QStringList headerStringList;
+    QVector<Column> columns;
+
+    int numRows;
+};
+
+#endif // COLUMNARTABLE_H
@@ -42,6 +42,8 @@ UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 #include <qgsfeature.h>
 #include <qgsfeaturerequest.h>
 
+#include <algorithm>
+
 ComponentDatabase::ComponentDatabase(QString type) : offset(0), componentType(type)
 {
     messageHandler = ProgramOutputDialog::getInstance();
@@ -63,7 +65,7 @@ bool ComponentDatabase::isEmpty(void)
 void ComponentDatabase::clear(void)
 {
     mainLayer = nullptr;
-    selectedFeaturesSet.clear();
+    selectedLayerIds.clear();
     offset = 0;
     selectedLayer = nullptr;
 }
@@ -120,35 +122,43 @@ void ComponentDatabase::setSelectedLayer(QgsVectorLayer *value)
 }
 
 
-bool ComponentDatabase::addFeaturesToSelectedLayer(const std::set<int> ids)
+bool ComponentDatabase::addFeaturesToSelectedLayer(const ComponentIDSet& ids)
 {
-    if(!selectedFeaturesSet.isEmpty())
-    {
-        selectedFeaturesSet.clear();
+    if(!selectedLayerIds.isEmpty())
         this->clearSelectedLayer();
-    }
-
-    selectedFeaturesSet.reserve(ids.size());
 
+    QgsFeatureIds idsToAdd;
     for(auto&& id : ids)
-        selectedFeaturesSet.insert(id+offset);
+        idsToAdd.insert(id+offset);
 
-    auto featIt = mainLayer->getFeatures(selectedFeaturesSet);
+    auto featIt = mainLayer->getFeatures(idsToAdd);
 
     QgsFeatureList featList;
-    featList.reserve(ids.size());
+    featList.reserve(idsToAdd.size());
+
+    QVector<QgsFeatureId> mainLayerIds;
+    mainLayerIds.reserve(idsToAdd.size());
 
     QgsFeature feat;
     while (featIt.nextFeature(feat))
     {
-        auto id = feat.id();
+        mainLayerIds.push_back(feat.id());
         featList.push_back(feat);
     }
 
-    if(featList.size() != ids.size())
+    if(featList.size() != idsToAdd.size())
         return false;
 
-    auto res = selectedLayer->dataProvider()->addFeatures(featList, QgsFeatureSink::FastInsert);
+    // Not a fast insert, the provider needs to write the new feature ids back into the list
+    auto res = selectedLayer->dataProvider()->addFeatures(featList);
+
+    if(res)
+    {
+        selectedLayerIds.reserve(selectedLayerIds.size() + featList.size());
+
+        for(int i = 0; i<featList.size(); ++i)
+            selectedLayerIds.insert(mainLayerIds.at(i), featList.at(i).id());
+    }
 
     selectedLayer->updateExtents();
 
@@ -160,10 +170,10 @@ bool ComponentDatabase::addFeatureToSelectedLayer(const int id)
 {
     auto fid = id+offset;
 
-    if(selectedFeaturesSet.contains(fid))
+    if(selectedLayerIds.contains(fid))
         return true;
 
-    auto feature = this->getFeature(fid);
+    auto feature = this->getFeature(id);
     if(feature.isValid() == false)
     {
         messageHandler->appendErrorMessage("Error getting the feature from the database");
@@ -178,7 +188,8 @@ bool ComponentDatabase::addFeatureToSelectedLayer(QgsFeature& feature)
 {
     auto fid = feature.id();
 
-    auto res = selectedLayer->dataProvider()->addFeature(feature, QgsFeatureSink::FastInsert);
+    // Not a fast insert, the provider needs to write the new feature id back into the feature
+    auto res = selectedLayer->dataProvider()->addFeature(feature);
 
     // auto res = selectedLayer->addFeature(feature/*, QgsFeatureSink::FastInsert*/);
 
@@ -188,7 +199,7 @@ bool ComponentDatabase::addFeatureToSelectedLayer(QgsFeature& feature)
         return false;
     }
 
-    selectedFeaturesSet.insert(fid);
+    selectedLayerIds.insert(fid, feature.id());
 
     return true;
 }
@@ -204,6 +215,20 @@ bool ComponentDatabase::removeFeaturesFromSelectedLayer(QgsFeatureIds& featureId
 {
     auto res = selectedLayer->dataProvider()->deleteFeatures(featureIds);
 
+    if(!res)
+        return res;
+
+    // The ids are those of the selected layer, drop the index entries that point to them
+    for(auto it = selectedLayerIds.begin(); it != selectedLayerIds.end();)
+    {
+        if(featureIds.contains(it.value()))
+            it = selectedLayerIds.erase(it);
+        else
+            ++it;
+    }
+
+    selectedLayer->updateExtents();
+
     return res;
 }
 
@@ -212,10 +237,22 @@ bool ComponentDatabase::clearSelectedLayer(void)
 {
     auto res = selectedLayer->dataProvider()->truncate();
 
+    selectedLayerIds.clear();
+
     return res;
 }
 
 
+QList<QgsFeatureId> ComponentDatabase::getSortedSelectedIds(void) const
+{
+    auto ids = selectedLayerIds.keys();
+
+    std::sort(ids.begin(), ids.end());
+
+    return ids;
+}
+
+
 bool ComponentDatabase::addNewComponentAttributes(const QStringList& fieldNames, const QVector<QgsAttributes>& values, QString& error)
 {
     if(selectedLayer == nullptr)
@@ -224,7 +261,7 @@ bool ComponentDatabase::addNewComponentAttributes(const QStringList& fieldNames,
         return false;
     }
 
-    auto numSelectedFeatures = selectedFeaturesSet.size();
+    auto numSelectedFeatures = selectedLayerIds.size();
 
     auto numFeatSelLayer = selectedLayer->featureCount();
 
@@ -252,78 +289,49 @@ bool ComponentDatabase::addNewComponentAttributes(const QStringList& fieldNames,
     }
 
 
-    QgsFields existingFields = selectedLayer->dataProvider()->fields();
+    // Only add the fields that are not already in the layer, e.g., when the results are imported a second time
+    auto selectedProvider = selectedLayer->dataProvider();
 
+    QList<QgsField> fieldsToAdd;
     for(int i = 0; i <numNewFields; ++i)
-        existingFields.append(QgsField(fieldNames[i], firstRow.at(i).type()));
-
-
-    QgsFeatureRequest featRequest (selectedFeaturesSet);
-
-    // All this just to get the feature request to return everything with ascending ids
-    QgsFeatureRequest::OrderByClause orderByClause(QString("id"),true);
-    QList<QgsFeatureRequest::OrderByClause> obcList = {orderByClause};
-    QgsFeatureRequest::OrderBy orderBy(obcList);
-    featRequest.setOrderBy(orderBy);
-
-    auto featIt = mainLayer->getFeatures(featRequest);
-
-    QgsFeatureList featList;
-    featList.reserve(values.size());
-
-    int count = 0;
-    QgsFeature feat;
-    while (featIt.nextFeature(feat))
     {
-        auto existingAtrb = feat.attributes();
-
-        // auto id = feat.id();
-        feat.setFields(existingFields, true);
-
-        auto newAtrb = values[count];
+        if(selectedProvider->fieldNameIndex(fieldNames[i]) == -1)
+            fieldsToAdd.append(QgsField(fieldNames[i], firstRow.at(i).type()));
+    }
 
-        existingAtrb.append(newAtrb);
+    if(!fieldsToAdd.isEmpty())
+    {
+        auto res = selectedProvider->addAttributes(fieldsToAdd);
 
-        // The number of provided attributes need to exactly match the number of the feature's fields.
-        feat.setAttributes(existingAtrb);
+        if(!res)
+        {
+            error = "Error adding attributes to the layer" + selectedLayer->name();
+            return false;
+        }
 
-        featList.push_back(feat);
-        ++count;
+        selectedLayer->updateFields(); // tell the vector layer to fetch changes from the provider
     }
 
-    if(values.size() != featList.size())
-    {
-        error = "Error, inconsist sizes of values to update and number of updated features. Please contact developers. Could not add fields to "+selectedLayer->name();
-        return false;
-    }
+    // The rows of values are in the order of ascending ids, the values are set in place in one batch
+    auto sortedIds = this->getSortedSelectedIds();
 
-    auto res = selectedLayer->dataProvider()->truncate();
+    QVector<AttributeChange> changes;
+    changes.reserve(sortedIds.size()*numNewFields);
 
-    if(!res)
+    for(int count = 0; count<sortedIds.size(); ++count)
     {
-        error = "Error, failed to remove existing features in the 'Selected Asset Layer' data provider. Please contact developers. Could not add fields to "+selectedLayer->name();
-        return false;
-    }
+        auto id = sortedIds.at(count)-offset;
 
-    res = selectedLayer->dataProvider()->addAttributes(existingFields.toList());
+        const auto& rowValues = values.at(count);
 
-    if(!res)
-    {
-         error = "Error adding attributes to the layer" + selectedLayer->name();
-         return false;
+        for(int i = 0; i <numNewFields; ++i)
+            changes.push_back({id, fieldNames.at(i), rowValues.value(i)});
     }
 
-    selectedLayer->updateFields(); // tell the vector layer to fetch changes from the provider
-
-    res = selectedLayer->dataProvider()->addFeatures(featList);
+    auto res = this->updateComponentAttributes(changes, error);
 
     if(!res)
-    {
-        error = "Error, failed to add features to the 'Selected Asset Layer' data provider. Please contact developers. Could not add fields to "+selectedLayer->name();
-        return false;
-    }
-
-    selectedLayer->updateExtents();
+        error += ". Could not add fields to "+selectedLayer->name();
 
     return res;
 }
@@ -338,7 +346,7 @@ bool ComponentDatabase::updateComponentAttributes(const QString& fieldName, cons
         return false;
     }
 
-    auto numSelectedFeatures = selectedFeaturesSet.size();
+    auto numSelectedFeatures = selectedLayerIds.size();
 
     auto numFeatSelLayer = selectedLayer->featureCount();
 
@@ -348,106 +356,132 @@ bool ComponentDatabase::updateComponentAttributes(const QString& fieldName, cons
         return false;
     }
 
-    auto field = selectedLayer->dataProvider()->fieldNameIndex(fieldName);
-
-    if(field == -1)
+    if(selectedLayer->dataProvider()->fieldNameIndex(fieldName) == -1)
     {
         error = "Error, failed to find the field "+fieldName+" in the imported results";
         return false;
     }
 
-    QgsFeatureRequest featRequest (selectedFeaturesSet);
+    // The values are in the order of ascending ids
+    auto sortedIds = this->getSortedSelectedIds();
 
-    // All this just to get the feature request to return everything with ascending ids
-    QgsFeatureRequest::OrderByClause orderByClause(QString("id"),true);
-    QList<QgsFeatureRequest::OrderByClause> obcList = {orderByClause};
-    QgsFeatureRequest::OrderBy orderBy(obcList);
-    featRequest.setOrderBy(orderBy);
+    QVector<AttributeChange> changes;
+    changes.reserve(values.size());
 
-    auto featIt = mainLayer->getFeatures(featRequest);
-
-    QgsFeatureList featList;
-    featList.reserve(values.size());
-
-    int count = 0;
-    QgsFeature feat;
-    while (featIt.nextFeature(feat))
-    {
-        // auto id = feat.id();
-        auto attrb = values[count];
+    for(int count = 0; count<sortedIds.size(); ++count)
+        changes.push_back({sortedIds.at(count)-offset, fieldName, values.at(count)});
 
-        feat.setAttribute(field,attrb);
+    return this->updateComponentAttributes(changes, error);
+}
 
-        featList.push_back(feat);
-        ++count;
-    }
 
-    if(values.size() != featList.size())
+bool ComponentDatabase::updateComponentAttributes(const QVector<AttributeChange>& changes, QString& error)
+{
+    if(mainLayer == nullptr)
     {
-        error = "Error, inconsist sizes of values to update and number of updated features. Please contact developers. Could not batch update field: "+fieldName;
+        error = "Error, could not find the layer containing the assets. Could not update the attributes";
         return false;
     }
 
-    auto res = selectedLayer->dataProvider()->truncate();
+    if(changes.isEmpty())
+        return true;
 
-    if(!res)
-    {
-        error = "Error, failed to remove existing features in the 'Selected Asset Layer' data provider. Please contact developers. Could not batch update field: "+fieldName;
-        return false;
-    }
+    auto mainProvider = mainLayer->dataProvider();
+    auto selectedProvider = selectedLayer != nullptr ? selectedLayer->dataProvider() : nullptr;
 
-    res = selectedLayer->dataProvider()->addFeatures(featList);
+    // Look up the index of every field only once
+    QHash<QString, QPair<int,int>> fieldIndices;
 
-    if(!res)
+    QgsChangedAttributesMap mainChanges;
+    QgsChangedAttributesMap selectedChanges;
+
+    for(auto&& change : changes)
     {
-        error = "Error, failed to add features to the 'Selected Asset Layer' data provider. Please contact developers. Could not batch update field: "+fieldName;
-        return false;
-    }
+        auto fid = change.id+offset;
 
-    selectedLayer->updateExtents();
+        if(FID_IS_NULL(fid))
+        {
+            error = "Error, invalid id "+QString::number(change.id)+" when updating the field "+change.fieldName;
+            return false;
+        }
 
-    return res;
-}
+        QPair<int,int> indices(-1,-1);
 
+        auto fieldIt = fieldIndices.constFind(change.fieldName);
 
-bool ComponentDatabase::updateComponentAttribute(const qint64 id, const QString& attribute, const QVariant& value)
-{
+        if(fieldIt != fieldIndices.constEnd())
+        {
+            indices = fieldIt.value();
+        }
+        else
+        {
+            indices.first = mainProvider->fieldNameIndex(change.fieldName);
 
-    auto fid = id+offset;
+            indices.second = selectedProvider != nullptr ? selectedProvider->fieldNameIndex(change.fieldName) : -1;
 
-    auto field = selectedLayer->dataProvider()->fieldNameIndex(attribute);
+            if(indices.first == -1 && indices.second == -1)
+            {
+                error = "Error, failed to find the field "+change.fieldName+" in the asset layers";
+                return false;
+            }
 
-    if(FID_IS_NULL(fid) || field == -1)
-        return false;
+            fieldIndices.insert(change.fieldName, indices);
+        }
 
-    mainLayer->startEditing();
+        auto mainField = indices.first;
+        auto selectedField = indices.second;
 
-    auto res = mainLayer->changeAttributeValue(fid,field,value);
+        if(mainField != -1)
+            mainChanges[fid].insert(mainField, change.value);
 
-    mainLayer->commitChanges(true);
+        // Only update the selected layer if the feature is in it
+        if(selectedField != -1)
+        {
+            auto selectedId = selectedLayerIds.value(fid, FID_NULL);
 
-    if(!res)
-        return res;
+            if(!FID_IS_NULL(selectedId))
+                selectedChanges[selectedId].insert(selectedField, change.value);
+        }
+    }
 
-    // Update the selected layer if there is one...
-    if(selectedLayer != nullptr)
+    if(!mainChanges.isEmpty())
     {
-        auto fidSel = selectedFeaturesSet.values().indexOf(id);
+        auto res = mainProvider->changeAttributeValues(mainChanges);
+
+        if(!res)
+        {
+            error = "Error, failed to update the attribute values in the layer "+mainLayer->name();
+            return false;
+        }
+
+        mainLayer->triggerRepaint();
+    }
 
-        // Still return true if feature is not in the set
-        if(fidSel == -1)
-            return true;
+    if(!selectedChanges.isEmpty())
+    {
+        auto res = selectedProvider->changeAttributeValues(selectedChanges);
 
-        auto res2 = selectedLayer->changeAttributeValue(fidSel,field,value);
+        if(!res)
+        {
+            error = "Error, failed to update the attribute values in the layer "+selectedLayer->name();
+            return false;
+        }
 
-        if(!res2)
-            return res2;
+        selectedLayer->triggerRepaint();
     }
 
     return true;
 }
 
 
+bool ComponentDatabase::updateComponentAttribute(const qint64 id, const QString& attribute, const QVariant& value)
+{
+    QString error;
+
+    return this->updateComponentAttributes({AttributeChange{id, attribute, value}}, error);
+}
+
+
 QVariant ComponentDatabase::getAttributeValue(const qint64 id, const QString& attribute, const QVariant defaultVal)
 {
     QVariant val(defaultVal);
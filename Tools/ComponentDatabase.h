@@ -45,7 +45,7 @@ UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 #include <qgsattributes.h>
 #include <qgsvectorlayer.h>
 
-#include <set>
+#include "ComponentIDSet.h"
 
 class ProgramOutputDialog;
 
@@ -56,14 +56,22 @@ class ComponentDatabase
 public:
     ComponentDatabase(QString type);
 
+    // A change to the value of one attribute of one component
+    struct AttributeChange
+    {
+        qint64 id;
+        QString fieldName;
+        QVariant value;
+    };
+
     bool isEmpty(void);
 
     void clear(void);
 
     void startEditing(void);
 
-    // Fast, use for batch feature addition
-    bool addFeaturesToSelectedLayer(const std::set<int> ids);
+    // Fast, use for batch feature addition. Replaces the current selection
+    bool addFeaturesToSelectedLayer(const ComponentIDSet& ids);
 
     // Slow, only use for adding indvidual features when needed
     bool addFeatureToSelectedLayer(const int id);
@@ -71,12 +79,16 @@ public:
     bool removeFeaturesFromSelectedLayer(QgsFeatureIds& featureIds);
     bool clearSelectedLayer(void);
 
-    // Slow, only use for sparse updates
+    // Use for sparse updates, each call is applied as a batch of one change
     bool updateComponentAttribute(const qint64 id, const QString& attribute, const QVariant& value);
 
-    // Fast, use for batch updates
+    // Fast, use for batch updates. The values are given for each selected component in the order of ascending ids
     bool updateComponentAttributes(const QString& fieldName, const QVector<QVariant>& values, QString& error);
 
+    // Applies all of the changes to the main and selected layers in one pass, one provider call per layer
+    // A field only has to exist in one of the layers, e.g., results fields are only in the selected layer
+    bool updateComponentAttributes(const QVector<AttributeChange>& changes, QString& error);
+
     // The field names passed as a vector and values passed as a matrix where each row is a component and each column is the fied value
     // The number of provided attributes need to exactly match the number of the feature's fields.
     bool addNewComponentAttributes(const QStringList& fieldNames, const QVector<QgsAttributes>& values, QString& error);
@@ -102,8 +114,12 @@ private:
 
     bool addFeatureToSelectedLayer(QgsFeature& feature);
 
-    // Selected feature set
-    QSet<long long> selectedFeaturesSet;
+    // Returns the ids of the selected features in the main layer, sorted in ascending order
+    QList<QgsFeatureId> getSortedSelectedIds(void) const;
+
+    // Index of the selected features, maps the id of a feature in the main layer to the id of its copy in the selected layer
+    // Kept up to date as features are added to, or removed from, the selected layer
+    QHash<QgsFeatureId, QgsFeatureId> selectedLayerIds;
 
     // Set of layers that this component may have features in
     QgsVectorLayer* mainLayer = nullptr;
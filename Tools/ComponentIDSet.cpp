@@ -0,0 +1,210 @@
+/* *****************************************************************************
+Copyright (c) 2016-2021, The Regents of the University of California (Regents).
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those
+of the authors and should not be interpreted as representing official policies,
+either expressed or implied, of the FreeBSD Project.
+
+REGENTS SPECIFICALLY DISCLAIMS ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+THE SOFTWARE AND ACCOMPANYING DOCUMENTATION, IF ANY, PROVIDED HEREUNDER IS
+PROVIDED "AS IS". REGENTS HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+
+*************************************************************************** */
+
+
+#include "ComponentIDSet.h"
+
+#include <algorithm>
+
+ComponentIDSet::const_iterator::const_iterator(const std::vector<Range>* ranges, size_t rangeIndex) : ranges(ranges), rangeIndex(rangeIndex)
+{
+    if(rangeIndex < ranges->size())
+        value = (*ranges)[rangeIndex].first;
+}
+
+
+ComponentIDSet::const_iterator& ComponentIDSet::const_iterator::operator++()
+{
+    if(value < (*ranges)[rangeIndex].last)
+    {
+        ++value;
+    }
+    else
+    {
+        ++rangeIndex;
+        if(rangeIndex < ranges->size())
+            value = (*ranges)[rangeIndex].first;
+    }
+
+    return *this;
+}
+
+
+ComponentIDSet::const_iterator ComponentIDSet::const_iterator::operator++(int)
+{
+    auto prev = *this;
+    ++(*this);
+    return prev;
+}
+
+
+ComponentIDSet::ComponentIDSet()
+{
+
+}
+
+
+void ComponentIDSet::insert(const int id)
+{
+    this->insertRange(id, id);
+}
+
+
+void ComponentIDSet::insertRange(const int first, const int last)
+{
+    if(first > last)
+        return;
+
+    // The first range that overlaps or touches the new one, i.e., the first range whose last ID is at least first-1
+    auto lo = std::lower_bound(ranges.begin(), ranges.end(), first, [](const Range& range, const int id)
+    {
+        return static_cast<qint64>(range.last) + 1 < id;
+    });
+
+    // One past the last range that overlaps or touches the new one
+    auto hi = lo;
+    while(hi != ranges.end() && static_cast<qint64>(hi->first) - 1 <= last)
+        ++hi;
+
+    if(lo == hi)
+    {
+        ranges.insert(lo, Range{first, last});
+        return;
+    }
+
+    // Merge the new range with all of the ones it overlaps
+    lo->first = std::min(lo->first, first);
+    lo->last = std::max((hi-1)->last, last);
+
+    ranges.erase(lo+1, hi);
+}
+
+
+void ComponentIDSet::clear(void)
+{
+    ranges.clear();
+}
+
+
+bool ComponentIDSet::empty(void) const
+{
+    return ranges.empty();
+}
+
+
+qint64 ComponentIDSet::size(void) const
+{
+    qint64 numIDs = 0;
+    for(auto&& range : ranges)
+        numIDs += static_cast<qint64>(range.last) - range.first + 1;
+
+    return numIDs;
+}
+
+
+bool ComponentIDSet::contains(const int id) const
+{
+    auto it = std::lower_bound(ranges.begin(), ranges.end(), id, [](const Range& range, const int val)
+    {
+        return range.last < val;
+    });
+
+    return it != ranges.end() && it->first <= id;
+}
+
+
+int ComponentIDSet::min(void) const
+{
+    return ranges.front().first;
+}
+
+
+int ComponentIDSet::max(void) const
+{
+    return ranges.back().last;
+}
+
+
+const std::vector<ComponentIDSet::Range>& ComponentIDSet::getRanges(void) const
+{
+    return ranges;
+}
+
+
+QString ComponentIDSet::toString(void) const
+{
+    QString stringList;
+
+    for(auto&& range : ranges)
+    {
+        if(!stringList.isEmpty())
+            stringList.append(",");
+
+        if(range.first == range.last)
+            stringList.append(QString::number(range.first));
+        else
+            stringList.append(QString::number(range.first)+"-"+QString::number(range.last));
+    }
+
+    return stringList;
+}
+
+
+ComponentIDSet::const_iterator ComponentIDSet::begin(void) const
+{
+    return const_iterator(&ranges, 0);
+}
+
+
+ComponentIDSet::const_iterator ComponentIDSet::end(void) const
+{
+    return const_iterator(&ranges, ranges.size());
+}
+
+
+bool ComponentIDSet::operator==(const ComponentIDSet& other) const
+{
+    if(ranges.size() != other.ranges.size())
+        return false;
+
+    for(size_t i = 0; i<ranges.size(); ++i)
+    {
+        if(ranges[i].first != other.ranges[i].first || ranges[i].last != other.ranges[i].last)
+            return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,122 @@
+#ifndef ComponentIDSet_H
+#define ComponentIDSet_H
+/* *****************************************************************************
+Copyright (c) 2016-2021, The Regents of the University of California (Regents).
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those
+of the authors and should not be interpreted as representing official policies,
+either expressed or implied, of the FreeBSD Project.
+
+REGENTS SPECIFICALLY DISCLAIMS ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+THE SOFTWARE AND ACCOMPANYING DOCUMENTATION, IF ANY, PROVIDED HEREUNDER IS
+PROVIDED "AS IS". REGENTS HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+
+*************************************************************************** */
+
+
+#include <QString>
+
+#include <iterator>
+#include <vector>
+
+// A set of component IDs stored as sorted, disjoint runs of consecutive IDs, e.g., 1,3,5-10
+// Memory is proportional to the number of runs rather than the number of IDs, so that a selection like 1-1000000 costs a single entry
+class ComponentIDSet
+{
+public:
+
+    // An inclusive run of consecutive IDs
+    struct Range
+    {
+        int first;
+        int last;
+    };
+
+    // Iterates over the individual IDs in ascending order
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = int;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const int*;
+        using reference = const int&;
+
+        const_iterator(const std::vector<Range>* ranges, size_t rangeIndex);
+
+        reference operator*() const { return value; }
+        pointer operator->() const { return &value; }
+
+        const_iterator& operator++();
+        const_iterator operator++(int);
+
+        bool operator==(const const_iterator& other) const { return rangeIndex == other.rangeIndex && (rangeIndex == ranges->size() || value == other.value); }
+        bool operator!=(const const_iterator& other) const { return !(*this == other); }
+
+    private:
+        const std::vector<Range>* ranges;
+        size_t rangeIndex;
+        int value = 0;
+    };
+
+    ComponentIDSet();
+
+    void insert(const int id);
+
+    // Inserts all of the IDs from first to last, inclusive
+    void insertRange(const int first, const int last);
+
+    void clear(void);
+
+    bool empty(void) const;
+
+    // The number of IDs in the set, not the number of ranges
+    qint64 size(void) const;
+
+    bool contains(const int id) const;
+
+    // The smallest and largest IDs, the set must not be empty
+    int min(void) const;
+    int max(void) const;
+
+    const std::vector<Range>& getRanges(void) const;
+
+    // Returns the IDs in the form 1,3,5-6,10,12,...
+    QString toString(void) const;
+
+    const_iterator begin(void) const;
+    const_iterator end(void) const;
+
+    bool operator==(const ComponentIDSet& other) const;
+    bool operator!=(const ComponentIDSet& other) const { return !(*this == other); }
+
+private:
+
+    // Sorted, non-overlapping and non-adjacent
+    std::vector<Range> ranges;
+};
+
+#endif // ComponentIDSet_H
@@ -0,0 +1,280 @@
+/* *****************************************************************************
+Copyright (c) 2016-2021, The Regents of the University of California (Regents).
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those
+of the authors and should not be interpreted as representing official policies,
+either expressed or implied, of the FreeBSD Project.
+
+REGENTS SPECIFICALLY DISCLAIMS ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+THE SOFTWARE AND ACCOMPANYING DOCUMENTATION, IF ANY, PROVIDED HEREUNDER IS
+PROVIDED "AS IS". REGENTS HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+
+*************************************************************************** */
+
+
+#include "EventGridFile.h"
+#include "CSVReaderWriter.h"
+
+#include <QFileInfo>
+#include <QDir>
+
+#include <algorithm>
+
+EventGridFile::EventGridFile()
+{
+
+}
+
+
+EventGridFile::~EventGridFile()
+{
+    this->closeSiteFile();
+
+    if(file.isOpen())
+    {
+        out.flush();
+        file.close();
+    }
+}
+
+
+QStringList EventGridFile::legacyGridHeader(void)
+{
+    return {"GP_file", "Latitude", "Longitude"};
+}
+
+
+int EventGridFile::open(const QString& pathToFile, const QStringList& IMNames, QString& err)
+{
+    if(IMNames.isEmpty())
+    {
+        err = "No intensity measures were given for the event grid file " + pathToFile;
+        return -1;
+    }
+
+    file.setFileName(pathToFile);
+
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        err = "Cannot create the file: " + pathToFile + "\n" +"Check your directory and try again.";
+        return -1;
+    }
+
+    out.setDevice(&file);
+
+    gridDir = QFileInfo(pathToFile).absolutePath();
+    IMHeader = IMNames;
+    writeError.clear();
+
+    numIMs = IMNames.size();
+    numSites = 0;
+
+    out<<legacyGridHeader().join(",")<<"\n";
+
+    return 0;
+}
+
+
+int EventGridFile::addSite(const double latitude, const double longitude, const QStringList& values)
+{
+    // Each site gets its own file, only the file of the last site is kept open for its realizations
+    this->closeSiteFile();
+
+    auto siteFileName = "Site_"+QString::number(numSites)+".csv";
+
+    siteFile.setFileName(gridDir + QDir::separator() + siteFileName);
+
+    if (!siteFile.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        if(writeError.isEmpty())
+            writeError = "Cannot create the file: " + siteFile.fileName() + "\n" +"Check your directory and try again.";
+        return -1;
+    }
+
+    siteOut.setDevice(&siteFile);
+
+    siteOut<<IMHeader.join(",")<<"\n";
+    this->writeValues(siteOut, values);
+
+    out<<siteFileName<<","<<QString::number(latitude,'g',10)<<","<<QString::number(longitude,'g',10)<<"\n";
+
+    return numSites++;
+}
+
+
+void EventGridFile::addRealization(const QStringList& values)
+{
+    if(numSites == 0)
+        return;
+
+    if(siteFile.isOpen())
+        this->writeValues(siteOut, values);
+}
+
+
+void EventGridFile::writeValues(QTextStream& stream, const QStringList& values)
+{
+    for(int i = 0; i<numIMs; ++i)
+    {
+        if(i != 0)
+            stream<<",";
+
+        if(i < values.size())
+            stream<<values.at(i);
+    }
+
+    stream<<"\n";
+}
+
+
+void EventGridFile::closeSiteFile(void)
+{
+    if(!siteFile.isOpen())
+        return;
+
+    siteOut.flush();
+
+    if((siteOut.status() != QTextStream::Ok || siteFile.error() != QFileDevice::NoError) && writeError.isEmpty())
+        writeError = "Error writing the site file " + siteFile.fileName() + ": " + siteFile.errorString();
+
+    siteFile.close();
+}
+
+
+int EventGridFile::close(QString& err)
+{
+    this->closeSiteFile();
+
+    if(!file.isOpen())
+        return 0;
+
+    out.flush();
+
+    if(out.status() != QTextStream::Ok || file.error() != QFileDevice::NoError)
+    {
+        err = "Error writing the event grid file " + file.fileName() + ": " + file.errorString();
+        file.close();
+        return -1;
+    }
+
+    file.close();
+
+    if(!writeError.isEmpty())
+    {
+        err = writeError;
+        return -1;
+    }
+
+    return 0;
+}
+
+
+int EventGridFile::read(const QString& pathToFile, QStringList& IMNames, QVector<EventGridSite>& sites, QString& err)
+{
+    IMNames.clear();
+    sites.clear();
+
+    CSVReaderWriter csvTool;
+
+    auto gridData = csvTool.parseCSVFile(pathToFile, err);
+
+    if(!err.isEmpty())
+        return -1;
+
+    if(gridData.isEmpty())
+    {
+        err = "The event grid file "+pathToFile+" is empty";
+        return -1;
+    }
+
+    auto header = gridData.first();
+
+    auto fileIndex = header.indexOf(legacyGridHeader().first());
+    auto latIndex = header.indexOf("Latitude");
+    auto lonIndex = header.indexOf("Longitude");
+
+    if(fileIndex == -1 || latIndex == -1 || lonIndex == -1)
+    {
+        err = "Could not find the "+legacyGridHeader().join(", ")+" columns in the event grid file "+pathToFile;
+        return -1;
+    }
+
+    auto gridDir = QFileInfo(pathToFile).absolutePath();
+
+    sites.reserve(gridData.size()-1);
+
+    for(int i = 1; i<gridData.size(); ++i)
+    {
+        auto gridRow = gridData.at(i);
+
+        if(gridRow.size() <= std::max(fileIndex, std::max(latIndex, lonIndex)))
+        {
+            err = "Wrong number of values in row "+QString::number(i)+" of the event grid file "+pathToFile;
+            return -1;
+        }
+
+        // The site file is given with or without its extension
+        auto siteName = gridRow.at(fileIndex);
+        if(siteName.endsWith(".csv", Qt::CaseInsensitive))
+            siteName.chop(4);
+
+        EventGridSite site;
+        site.name = siteName;
+        site.latitude = gridRow.at(latIndex).toDouble();
+        site.longitude = gridRow.at(lonIndex).toDouble();
+
+        auto pathToSiteFile = gridDir + QDir::separator() + siteName + ".csv";
+
+        auto siteData = csvTool.parseCSVFile(pathToSiteFile, err);
+
+        if(!err.isEmpty())
+            return -1;
+
+        if(siteData.size() < 2)
+        {
+            err = "The site file "+pathToSiteFile+" does not contain any data";
+            return -1;
+        }
+
+        if(IMNames.isEmpty())
+            IMNames = siteData.first();
+
+        for(int j = 1; j<siteData.size(); ++j)
+        {
+            auto siteRow = siteData.at(j);
+
+            QVector<double> values(IMNames.size());
+            for(int k = 0; k<IMNames.size() && k<siteRow.size(); ++k)
+                values[k] = siteRow.at(k).toDouble();
+
+            site.realizations.push_back(values);
+        }
+
+        sites.push_back(site);
+    }
+
+    return sites.size();
+}
@@ -0,0 +1,109 @@
+#ifndef EVENTGRIDFILE_H
+#define EVENTGRIDFILE_H
+/* *****************************************************************************
+Copyright (c) 2016-2021, The Regents of the University of California (Regents).
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those
+of the authors and should not be interpreted as representing official policies,
+either expressed or implied, of the FreeBSD Project.
+
+REGENTS SPECIFICALLY DISCLAIMS ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+THE SOFTWARE AND ACCOMPANYING DOCUMENTATION, IF ANY, PROVIDED HEREUNDER IS
+PROVIDED "AS IS". REGENTS HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+
+*************************************************************************** */
+
+
+#include <QFile>
+#include <QString>
+#include <QStringList>
+#include <QTextStream>
+#include <QVector>
+
+// A site of an event grid, with one row of intensity measure values per realization
+struct EventGridSite
+{
+    // Name of the site, the name of its site file without the extension
+    QString name;
+    double latitude = 0.0;
+    double longitude = 0.0;
+    QVector<QVector<double>> realizations;
+};
+
+
+// Reads and writes the sites of a hazard event grid in the layout that the backend applications read, an EventGrid.csv with the columns
+// GP_file, Latitude, Longitude and one Site_i.csv file per site, next to the grid file, with a header row of the intensity measures and one row per realization
+class EventGridFile
+{
+public:
+
+    EventGridFile();
+    ~EventGridFile();
+
+    // The header of the grid file, also used for the site lists that are given to the backend
+    static QStringList legacyGridHeader(void);
+
+    // Opens the grid file for writing and writes the header
+    int open(const QString& pathToFile, const QStringList& IMNames, QString& err);
+
+    // Appends a site, the values are the intensity measures in the order given to open()
+    // Returns the index of the site in the file, or -1 if the site could not be written
+    int addSite(const double latitude, const double longitude, const QStringList& values);
+
+    // Appends another realization to the last site that was added
+    void addRealization(const QStringList& values);
+
+    // Flushes and closes the files
+    int close(QString& err);
+
+    // Reads an event grid and its site files
+    // Returns the number of sites, or -1 on error
+    int read(const QString& pathToFile, QStringList& IMNames, QVector<EventGridSite>& sites, QString& err);
+
+private:
+
+    void writeValues(QTextStream& stream, const QStringList& values);
+
+    // Closes the site file of the last site
+    void closeSiteFile(void);
+
+    QFile file;
+    QTextStream out;
+
+    // The site file of the last site that was added
+    QFile siteFile;
+    QTextStream siteOut;
+
+    QString gridDir;
+    QStringList IMHeader;
+
+    QString writeError;
+
+    int numIMs = 0;
+    int numSites = 0;
+};
+
+#endif // EVENTGRIDFILE_H
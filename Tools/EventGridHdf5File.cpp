@@ -0,0 +1,231 @@
+/* *****************************************************************************
+Copyright (c) 2016-2021, The Regents of the University of California (Regents).
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those
+of the authors and should not be interpreted as representing official policies,
+either expressed or implied, of the FreeBSD Project.
+
+REGENTS SPECIFICALLY DISCLAIMS ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+THE SOFTWARE AND ACCOMPANYING DOCUMENTATION, IF ANY, PROVIDED HEREUNDER IS
+PROVIDED "AS IS". REGENTS HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+
+*************************************************************************** */
+
+
+#include "EventGridHdf5File.h"
+
+#ifdef INCLUDE_HDF5
+#include <hdf5.h>
+#endif
+
+#include <QByteArray>
+
+#include <algorithm>
+#include <vector>
+
+#ifdef INCLUDE_HDF5
+namespace {
+
+// Closes an HDF5 object when it goes out of scope
+class Hdf5Handle
+{
+public:
+    Hdf5Handle(hid_t id, herr_t (*closeFunction)(hid_t)) : id(id), closeFunction(closeFunction) {}
+
+    ~Hdf5Handle()
+    {
+        if(id >= 0)
+            closeFunction(id);
+    }
+
+    Hdf5Handle(const Hdf5Handle&) = delete;
+    Hdf5Handle& operator=(const Hdf5Handle&) = delete;
+
+    bool isValid(void) const { return id >= 0; }
+
+    operator hid_t() const { return id; }
+
+private:
+    hid_t id;
+    herr_t (*closeFunction)(hid_t);
+};
+
+
+bool writeCoordinates(hid_t file, const char* name, const QVector<double>& coordinates)
+{
+    hsize_t dims[1] = {static_cast<hsize_t>(coordinates.size())};
+
+    Hdf5Handle space(H5Screate_simple(1, dims, nullptr), H5Sclose);
+    if(!space.isValid())
+        return false;
+
+    Hdf5Handle dataset(H5Dcreate2(file, name, H5T_IEEE_F64LE, space, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT), H5Dclose);
+    if(!dataset.isValid())
+        return false;
+
+    return H5Dwrite(dataset, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, coordinates.constData()) >= 0;
+}
+
+}
+#endif
+
+
+EventGridHdf5File::EventGridHdf5File()
+{
+
+}
+
+
+bool EventGridHdf5File::isAvailable(void)
+{
+#ifdef INCLUDE_HDF5
+    return true;
+#else
+    return false;
+#endif
+}
+
+
+int EventGridHdf5File::write(const QString& pathToFile,
+                             const QStringList& IMNames,
+                             const QVector<double>& latitudes,
+                             const QVector<double>& longitudes,
+                             const QVector<double>& values,
+                             const int numEvents,
+                             QString& err)
+{
+    const auto numSites = latitudes.size();
+    const auto numIMs = IMNames.size();
+
+    if(numSites == 0 || numIMs == 0 || numEvents <= 0)
+    {
+        err = "Error, there are no sites, events or intensity measures to write to the HDF5 file";
+        return -1;
+    }
+
+    if(longitudes.size() != numSites || values.size() != static_cast<qint64>(numEvents)*numSites*numIMs)
+    {
+        err = "Error, the number of values does not match the number of events, sites and intensity measures in the HDF5 file";
+        return -1;
+    }
+
+#ifdef INCLUDE_HDF5
+
+    Hdf5Handle file(H5Fcreate(pathToFile.toLocal8Bit().constData(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT), H5Fclose);
+    if(!file.isValid())
+    {
+        err = "Error creating the HDF5 file "+pathToFile;
+        return -1;
+    }
+
+    hsize_t dims[3] = {static_cast<hsize_t>(numEvents), static_cast<hsize_t>(numSites), static_cast<hsize_t>(numIMs)};
+    hsize_t chunk[3] = {1, static_cast<hsize_t>(std::min(std::max(chunkSites, 1), numSites)), static_cast<hsize_t>(numIMs)};
+
+    Hdf5Handle space(H5Screate_simple(3, dims, nullptr), H5Sclose);
+    Hdf5Handle createProps(H5Pcreate(H5P_DATASET_CREATE), H5Pclose);
+    if(!space.isValid() || !createProps.isValid() || H5Pset_chunk(createProps, 3, chunk) < 0)
+    {
+        err = "Error setting up the intensity measure dataset in the HDF5 file";
+        return -1;
+    }
+
+    // The shuffle filter groups the bytes of the doubles, which makes them compress considerably better
+    if(compressionLevel > 0 && H5Zfilter_avail(H5Z_FILTER_DEFLATE) > 0)
+    {
+        H5Pset_shuffle(createProps);
+        H5Pset_deflate(createProps, static_cast<unsigned>(std::min(compressionLevel, 9)));
+    }
+
+    Hdf5Handle dataset(H5Dcreate2(file, "IntensityMeasures", H5T_IEEE_F64LE, space, H5P_DEFAULT, createProps, H5P_DEFAULT), H5Dclose);
+    if(!dataset.isValid() || H5Dwrite(dataset, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, values.constData()) < 0)
+    {
+        err = "Error writing the intensity measures to the HDF5 file";
+        return -1;
+    }
+
+    // The IM names as an attribute of variable length utf-8 strings
+    std::vector<QByteArray> namesUtf8;
+    std::vector<const char*> names;
+    namesUtf8.reserve(numIMs);
+    names.reserve(numIMs);
+    for(auto&& name : IMNames)
+    {
+        namesUtf8.push_back(name.toUtf8());
+        names.push_back(namesUtf8.back().constData());
+    }
+
+    hsize_t namesDims[1] = {static_cast<hsize_t>(numIMs)};
+
+    Hdf5Handle stringType(H5Tcopy(H5T_C_S1), H5Tclose);
+    Hdf5Handle namesSpace(H5Screate_simple(1, namesDims, nullptr), H5Sclose);
+    if(!stringType.isValid() || !namesSpace.isValid() || H5Tset_size(stringType, H5T_VARIABLE) < 0 || H5Tset_cset(stringType, H5T_CSET_UTF8) < 0)
+    {
+        err = "Error setting up the intensity measure names in the HDF5 file";
+        return -1;
+    }
+
+    Hdf5Handle namesAttribute(H5Acreate2(dataset, "IMNames", stringType, namesSpace, H5P_DEFAULT, H5P_DEFAULT), H5Aclose);
+    if(!namesAttribute.isValid() || H5Awrite(namesAttribute, stringType, names.data()) < 0)
+    {
+        err = "Error writing the intensity measure names to the HDF5 file";
+        return -1;
+    }
+
+    if(!writeCoordinates(file, "Latitude", latitudes) || !writeCoordinates(file, "Longitude", longitudes))
+    {
+        err = "Error writing the site coordinates to the HDF5 file";
+        return -1;
+    }
+
+    if(H5Fflush(file, H5F_SCOPE_LOCAL) < 0)
+    {
+        err = "Error flushing the HDF5 file "+pathToFile;
+        return -1;
+    }
+
+    return 0;
+
+#else
+
+    Q_UNUSED(pathToFile)
+
+    err = "Error, this build of the application does not include HDF5 support";
+    return -1;
+
+#endif
+}
+
+
+void EventGridHdf5File::setChunkSites(const int val)
+{
+    chunkSites = val;
+}
+
+
+void EventGridHdf5File::setCompressionLevel(const int val)
+{
+    compressionLevel = val;
+}
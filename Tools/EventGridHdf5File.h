@@ -0,0 +1,81 @@
+#ifndef EventGridHdf5File_H
+#define EventGridHdf5File_H
+/* *****************************************************************************
+Copyright (c) 2016-2021, The Regents of the University of California (Regents).
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those
+of the authors and should not be interpreted as representing official policies,
+either expressed or implied, of the FreeBSD Project.
+
+REGENTS SPECIFICALLY DISCLAIMS ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+THE SOFTWARE AND ACCOMPANYING DOCUMENTATION, IF ANY, PROVIDED HEREUNDER IS
+PROVIDED "AS IS". REGENTS HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+
+*************************************************************************** */
+
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+// Writes the sites of a hazard event grid to a single HDF5 file
+//
+// The file layout is:
+//      /IntensityMeasures  double [events x sites x IMs], chunked and compressed, with the IM names in the attribute IMNames
+//      /Latitude           double [sites]
+//      /Longitude          double [sites]
+//
+// HDF5 support is only available if the application was built with the HDF5 library, i.e., with INCLUDE_HDF5 defined
+class EventGridHdf5File
+{
+public:
+    EventGridHdf5File();
+
+    // Returns true if this build can write HDF5 files
+    static bool isAvailable(void);
+
+    // The values are in the events x sites x IMs row-major order
+    int write(const QString& pathToFile,
+              const QStringList& IMNames,
+              const QVector<double>& latitudes,
+              const QVector<double>& longitudes,
+              const QVector<double>& values,
+              const int numEvents,
+              QString& err);
+
+    // The number of sites per chunk of the intensity measure dataset
+    void setChunkSites(const int val);
+
+    // The deflate level from 0 to 9, where 0 turns off compression
+    void setCompressionLevel(const int val);
+
+private:
+
+    int chunkSites = 4096;
+    int compressionLevel = 4;
+};
+
+#endif // EventGridHdf5File_H
@@ -0,0 +1,480 @@
+/* *****************************************************************************
+Copyright (c) 2016-2021, The Regents of the University of California (Regents).
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those
+of the authors and should not be interpreted as representing official policies,
+either expressed or implied, of the FreeBSD Project.
+
+REGENTS SPECIFICALLY DISCLAIMS ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+THE SOFTWARE AND ACCOMPANYING DOCUMENTATION, IF ANY, PROVIDED HEREUNDER IS
+PROVIDED "AS IS". REGENTS HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+
+*************************************************************************** */
+
+
+#include "GeoJSONFeatureSplitter.h"
+
+#include <QDir>
+#include <QJsonArray>
+#include <QJsonDocument>
+
+namespace {
+
+// The size of the chunks that the input is read in, and the size at which an output buffer is written out
+const int readChunkSize = 4 << 20;
+const int flushSize = 1 << 20;
+
+
+bool isWhitespace(const char c)
+{
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+
+// Returns the index one past the end of the json value that starts at i, or -1 if the text ends before the value does
+// A number or literal that runs to the end of the text is returned as ending there
+int valueEnd(const QByteArray& text, int i)
+{
+    const auto n = text.size();
+
+    if(i >= n)
+        return -1;
+
+    auto c = text.at(i);
+
+    if(c == '"')
+    {
+        for(++i; i<n; ++i)
+        {
+            if(text.at(i) == '\\')
+                ++i;
+            else if(text.at(i) == '"')
+                return i+1;
+        }
+
+        return -1;
+    }
+
+    if(c == '{' || c == '[')
+    {
+        int depth = 0;
+        bool inString = false;
+
+        for(; i<n; ++i)
+        {
+            auto ch = text.at(i);
+
+            if(inString)
+            {
+                if(ch == '\\')
+                    ++i;
+                else if(ch == '"')
+                    inString = false;
+            }
+            else if(ch == '"')
+                inString = true;
+            else if(ch == '{' || ch == '[')
+                ++depth;
+            else if(ch == '}' || ch == ']')
+            {
+                if(--depth == 0)
+                    return i+1;
+            }
+        }
+
+        return -1;
+    }
+
+    while(i<n && !isWhitespace(text.at(i)) && text.at(i) != ',' && text.at(i) != '}' && text.at(i) != ']')
+        ++i;
+
+    return i;
+}
+
+
+// Returns the raw value of a top level member of the json object text, or an empty array if there is no such member
+QByteArray findMember(const QByteArray& object, const QByteArray& key)
+{
+    const auto n = object.size();
+    int i = 0;
+
+    auto skip = [&]() { while(i<n && isWhitespace(object.at(i))) ++i; };
+
+    skip();
+    if(i >= n || object.at(i) != '{')
+        return QByteArray();
+
+    ++i;
+
+    while(true)
+    {
+        skip();
+        if(i >= n || object.at(i) != '"')
+            return QByteArray();
+
+        auto keyEnd = valueEnd(object, i);
+        if(keyEnd < 0)
+            return QByteArray();
+
+        // The key without its quotes
+        auto isKey = (keyEnd - i - 2 == key.size()) && object.mid(i+1, key.size()) == key;
+
+        i = keyEnd;
+        skip();
+        if(i >= n || object.at(i) != ':')
+            return QByteArray();
+
+        ++i;
+        skip();
+
+        auto end = valueEnd(object, i);
+        if(end < 0)
+            return QByteArray();
+
+        if(isKey)
+            return object.mid(i, end - i);
+
+        i = end;
+        skip();
+        if(i < n && object.at(i) == ',')
+            ++i;
+    }
+}
+
+
+QString decodeString(const QByteArray& raw)
+{
+    auto doc = QJsonDocument::fromJson("[" + raw + "]");
+    return doc.array().at(0).toString();
+}
+
+}
+
+
+GeoJSONFeatureSplitter::GeoJSONFeatureSplitter()
+{
+
+}
+
+
+GeoJSONFeatureSplitter::~GeoJSONFeatureSplitter()
+{
+
+}
+
+
+int GeoJSONFeatureSplitter::split(const QString& pathToFile, const QString& outputDir, const RouteFunction& route, QString& err)
+{
+    this->reset();
+
+    outputDirectory = outputDir;
+
+    inputFile.setFileName(pathToFile);
+    if(!inputFile.open(QFile::ReadOnly))
+    {
+        err = "Failed to open the file at location: "+pathToFile;
+        return -1;
+    }
+
+    auto parseError = [&](const QString& msg) -> int
+    {
+        err = "Error parsing the GeoJSON file "+pathToFile+": "+msg;
+        this->reset();
+        return -1;
+    };
+
+    if(!this->skipWhitespace() || buffer.at(pos) != '{')
+        return parseError("the file does not contain a json object");
+
+    ++pos;
+
+    while(true)
+    {
+        if(!this->skipWhitespace())
+            return parseError("unexpected end of the file");
+
+        if(buffer.at(pos) == '}')
+            break;
+
+        if(buffer.at(pos) == ',')
+        {
+            ++pos;
+            continue;
+        }
+
+        QByteArray rawKey;
+        if(buffer.at(pos) != '"' || !this->captureValue(rawKey))
+            return parseError("expected a member name");
+
+        auto key = decodeString(rawKey);
+        topLevelMembers.append(key);
+
+        if(!this->skipWhitespace() || buffer.at(pos) != ':')
+            return parseError("expected a ':' after the member "+key);
+
+        ++pos;
+
+        if(!this->skipWhitespace())
+            return parseError("unexpected end of the file");
+
+        if(key == "features")
+        {
+            if(buffer.at(pos) != '[')
+                return parseError("the features member is not an array");
+
+            ++pos;
+
+            // Route the features one at a time
+            while(true)
+            {
+                if(!this->skipWhitespace())
+                    return parseError("unexpected end of the features array");
+
+                auto c = buffer.at(pos);
+
+                if(c == ']')
+                {
+                    ++pos;
+                    break;
+                }
+
+                if(c == ',')
+                {
+                    ++pos;
+                    continue;
+                }
+
+                QByteArray feature;
+                if(!this->captureValue(feature))
+                    return parseError("unexpected end of a feature");
+
+                if(!this->writeFeature(feature, route, err))
+                {
+                    this->reset();
+                    return -1;
+                }
+            }
+        }
+        else
+        {
+            QByteArray value;
+            if(!this->captureValue(value))
+                return parseError("unexpected end of the member "+key);
+
+            if(key == "crs")
+                crs = QJsonDocument::fromJson(value).object();
+        }
+    }
+
+    return this->finish(err);
+}
+
+
+QStringList GeoJSONFeatureSplitter::getGroupNames(void) const
+{
+    QStringList names;
+    for(auto&& it : groups)
+        names.append(it.first);
+
+    return names;
+}
+
+
+QString GeoJSONFeatureSplitter::getGroupFilePath(const QString& name) const
+{
+    auto it = groups.find(name);
+    if(it == groups.end())
+        return QString();
+
+    return it->second->file.fileName();
+}
+
+
+QJsonObject GeoJSONFeatureSplitter::getCrs(void) const
+{
+    return crs;
+}
+
+
+QStringList GeoJSONFeatureSplitter::getTopLevelMembers(void) const
+{
+    return topLevelMembers;
+}
+
+
+bool GeoJSONFeatureSplitter::readMore(void)
+{
+    auto chunk = inputFile.read(readChunkSize);
+    if(chunk.isEmpty())
+        return false;
+
+    // Drop what has already been consumed
+    buffer.remove(0, pos);
+    pos = 0;
+
+    buffer.append(chunk);
+
+    return true;
+}
+
+
+bool GeoJSONFeatureSplitter::skipWhitespace(void)
+{
+    while(true)
+    {
+        while(pos < buffer.size() && isWhitespace(buffer.at(pos)))
+            ++pos;
+
+        if(pos < buffer.size())
+            return true;
+
+        if(!this->readMore())
+            return false;
+    }
+}
+
+
+bool GeoJSONFeatureSplitter::captureValue(QByteArray& value)
+{
+    while(true)
+    {
+        auto end = valueEnd(buffer, pos);
+
+        // A number or literal that runs to the end of the buffer may continue in the next chunk
+        auto c = pos < buffer.size() ? buffer.at(pos) : '\0';
+        auto isLiteral = c != '{' && c != '[' && c != '"';
+        auto needMore = end < 0 || (isLiteral && end == buffer.size());
+
+        if(!needMore)
+        {
+            value = buffer.mid(pos, end - pos);
+            pos = end;
+            return true;
+        }
+
+        if(!this->readMore())
+        {
+            if(end < 0 || end == pos)
+                return false;
+
+            value = buffer.mid(pos, end - pos);
+            pos = end;
+            return true;
+        }
+    }
+}
+
+
+bool GeoJSONFeatureSplitter::writeFeature(const QByteArray& feature, const RouteFunction& route, QString& err)
+{
+    // Only the properties are parsed, the feature is copied as is
+    auto properties = QJsonDocument::fromJson(findMember(feature, "properties")).object();
+
+    auto name = route(properties);
+
+    auto& output = groups[name];
+    if(!output)
+    {
+        output = std::make_unique<GroupOutput>();
+        output->file.setFileName(outputDirectory + QDir::separator() + name + ".geojson");
+
+        if(!output->file.open(QFile::WriteOnly | QFile::Text))
+        {
+            err = "Error creating the output file "+output->file.fileName();
+            return false;
+        }
+
+        output->buffer.reserve(flushSize + (1 << 16));
+        output->buffer.append("{\n\"type\": \"FeatureCollection\",\n\"features\": [\n");
+    }
+
+    if(output->numFeatures > 0)
+        output->buffer.append(",\n");
+
+    output->buffer.append(feature);
+    ++output->numFeatures;
+
+    if(output->buffer.size() >= flushSize)
+        return this->flush(*output, err);
+
+    return true;
+}
+
+
+bool GeoJSONFeatureSplitter::flush(GroupOutput& output, QString& err)
+{
+    if(output.file.write(output.buffer) != output.buffer.size())
+    {
+        err = "Error writing to the file "+output.file.fileName()+": "+output.file.errorString();
+        return false;
+    }
+
+    output.buffer.clear();
+
+    return true;
+}
+
+
+int GeoJSONFeatureSplitter::finish(QString& err)
+{
+    inputFile.close();
+    buffer.clear();
+    pos = 0;
+
+    // The crs is written after the features since it may come after them in the input
+    QByteArray tail("\n]");
+    if(!crs.isEmpty())
+        tail.append(",\n\"crs\": " + QJsonDocument(crs).toJson(QJsonDocument::Compact));
+    tail.append("\n}\n");
+
+    for(auto&& it : groups)
+    {
+        auto& output = *it.second;
+
+        output.buffer.append(tail);
+
+        if(!this->flush(output, err))
+            return -1;
+
+        output.file.close();
+    }
+
+    return 0;
+}
+
+
+void GeoJSONFeatureSplitter::reset(void)
+{
+    if(inputFile.isOpen())
+        inputFile.close();
+
+    buffer.clear();
+    pos = 0;
+
+    groups.clear();
+    crs = QJsonObject();
+    topLevelMembers.clear();
+}
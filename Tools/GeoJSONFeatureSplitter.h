@@ -0,0 +1,111 @@
+#ifndef GeoJSONFeatureSplitter_H
+#define GeoJSONFeatureSplitter_H
+/* *****************************************************************************
+Copyright (c) 2016-2021, The Regents of the University of California (Regents).
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those
+of the authors and should not be interpreted as representing official policies,
+either expressed or implied, of the FreeBSD Project.
+
+REGENTS SPECIFICALLY DISCLAIMS ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+THE SOFTWARE AND ACCOMPANYING DOCUMENTATION, IF ANY, PROVIDED HEREUNDER IS
+PROVIDED "AS IS". REGENTS HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+
+*************************************************************************** */
+
+
+#include <QByteArray>
+#include <QFile>
+#include <QJsonObject>
+#include <QString>
+#include <QStringList>
+
+#include <functional>
+#include <map>
+#include <memory>
+
+// Splits a GeoJSON feature collection into one feature collection file per group of features without loading the whole collection
+// The input is read in chunks and each feature is copied verbatim into the file of its group, so memory use does not depend on the size of the input
+class GeoJSONFeatureSplitter
+{
+public:
+    // Returns the name of the group that a feature belongs to from the feature properties, e.g., the asset type
+    using RouteFunction = std::function<QString(const QJsonObject& properties)>;
+
+    GeoJSONFeatureSplitter();
+    ~GeoJSONFeatureSplitter();
+
+    // Writes the features of each group to outputDir/<group>.geojson
+    int split(const QString& pathToFile, const QString& outputDir, const RouteFunction& route, QString& err);
+
+    // The groups that were written, in ascending order
+    QStringList getGroupNames(void) const;
+
+    QString getGroupFilePath(const QString& name) const;
+
+    // The crs member of the input collection, empty if it has none
+    QJsonObject getCrs(void) const;
+
+    // The names of the top level members of the input collection
+    QStringList getTopLevelMembers(void) const;
+
+private:
+
+    struct GroupOutput
+    {
+        QFile file;
+        QByteArray buffer;
+        int numFeatures = 0;
+    };
+
+    // Reads more of the input into the buffer, returns false at the end of the file
+    bool readMore(void);
+
+    bool skipWhitespace(void);
+
+    // Copies the raw text of the json value that starts at the current position and moves past it
+    bool captureValue(QByteArray& value);
+
+    bool writeFeature(const QByteArray& feature, const RouteFunction& route, QString& err);
+
+    bool flush(GroupOutput& output, QString& err);
+
+    int finish(QString& err);
+
+    void reset(void);
+
+    QFile inputFile;
+    QByteArray buffer;
+    int pos = 0;
+
+    QString outputDirectory;
+    std::map<QString, std::unique_ptr<GroupOutput>> groups;
+
+    QJsonObject crs;
+    QStringList topLevelMembers;
+};
+
+#endif // GeoJSONFeatureSplitter_H
@@ -39,11 +39,13 @@ UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 #include "GeoJSONReaderWriter.h"
 
 #include <QVector>
-#include <QJsonArray>
-#include <QJsonObject>
-#include <QJsonDocument>
 #include <QStringList>
+#include <QByteArray>
+#include <QIODevice>
 #include <QFile>
+#include <QLocale>
+
+#include <algorithm>
 
 GeoJSONReaderWriter::GeoJSONReaderWriter()
 {
@@ -57,7 +59,27 @@ int GeoJSONReaderWriter::saveGeoJsonFile(const QVector<QStringList>& data,
                                          const QString& pathToFile,
                                          QString& err)
 {
+    QFile file(pathToFile);
+    if (!file.open(QFile::WriteOnly | QFile::Text))
+    {
+        err = "Error creating the asset output json file in GeojsonAssetInputWidget";
+        return -1;
+    }
+
+    auto res = this->writeGeoJson(data, headers, assetType, file, err);
 
+    file.close();
+
+    return res;
+}
+
+
+int GeoJSONReaderWriter::writeGeoJson(const QVector<QStringList>& data,
+                                      const QStringList& headers,
+                                      const QString assetType,
+                                      QIODevice& device,
+                                      QString& err)
+{
     auto indexFootprint = this->getIndexOfVal(headers, "footprint");
     auto indexLatitude = -1;
     auto indexLongitude = -1;
@@ -80,103 +102,112 @@ int GeoJSONReaderWriter::saveGeoJsonFile(const QVector<QStringList>& data,
         }
     }
 
-    QJsonObject assetDictionary;
-    assetDictionary["type"]="FeatureCollection";
-
-    QJsonObject crs;
-    crs["type"] = "name";
-    QJsonObject properties;
-
-    // All simcenter tables should be in the 4326 CRS, i.e., lat./lon.
-    properties["name"] = "urn:ogc:def:crs:EPSG::4326";
-    crs["properties"] = properties;
-
-    assetDictionary["crs"]=crs;
-
-    auto numCol = data.first().size();
-
     // Check that there are items in each row and that the number of items is consistent
-    if(numCol==0)
+    if(data.isEmpty() || data.first().isEmpty())
     {
         err = "Empty data vector came into the function save data.";
-        return false;
+        return -1;
     }
 
-    auto dataCopy = data;
+    auto numCol = std::min(data.first().size(), headers.size());
 
-    dataCopy.removeFirst();
+    // The property keys are the same for every feature, escape them once
+    QVector<QByteArray> propertyKeys;
+    propertyKeys.reserve(numCol);
+    for(int i = 0; i<numCol; ++i)
+    {
+        QByteArray key;
+        this->appendJsonString(key, headers[i]);
+        key.append(':');
+        propertyKeys.append(key);
+    }
 
-    QJsonArray featuresArray;
+    QByteArray typeProperty("\"type\":");
+    this->appendJsonString(typeProperty, assetType);
+
+    // All simcenter tables should be in the 4326 CRS, i.e., lat./lon.
+    QByteArray buffer("{\"type\":\"FeatureCollection\",\n"
+                      "\"crs\":{\"type\":\"name\",\"properties\":{\"name\":\"urn:ogc:def:crs:EPSG::4326\"}},\n"
+                      "\"features\":[\n");
 
-    for(auto&& row : dataCopy)
+    // Flush to the device in chunks so that memory stays flat regardless of the number of features
+    const int flushSize = 1 << 20;
+    buffer.reserve(flushSize + (1 << 16));
+
+    auto flush = [&]() -> bool
     {
+        if(device.write(buffer) != buffer.size())
+        {
+            err = "Error writing the GeoJson file: " + device.errorString();
+            return false;
+        }
+        buffer.clear();
+        return true;
+    };
+
+    // The first row is the header row
+    for(int r = 1; r<data.size(); ++r)
+    {
+        const auto& row = data.at(r);
+
+        if(row.size() < numCol || (indexFootprint != -1 && indexFootprint >= row.size()) || (indexFootprint == -1 && std::max(indexLatitude, indexLongitude) >= row.size()))
+        {
+            err = "Inconsistent number of columns in row " + QString::number(r) + " of the GeoJson data";
+            return -1;
+        }
+
         // Each row in the table is a feature
-        QJsonObject feature;
+        if(r > 1)
+            buffer.append(",\n");
+
+        buffer.append("{\"type\":\"Feature\",\"geometry\":");
 
         // Parse the geometry
         if (indexFootprint != -1)
         {
-            QString footPrintString = row[indexFootprint];
+            // The footprint is a feature json string, copy its geometry over verbatim
+            auto geometry = this->extractGeometry(row.at(indexFootprint));
 
-            // First, convert the json string to a QByteArray
-            QByteArray jsonByteArray = footPrintString.toUtf8();
-
-            // Then, parse the json byte array to a QJsonDocument
-            QJsonDocument jsonDocument = QJsonDocument::fromJson(jsonByteArray);
-
-            // Finally, extract the QJsonObject from the QJsonDocument
-            feature = jsonDocument.object();
+            if(geometry.isEmpty())
+                buffer.append("null");
+            else
+                buffer.append(geometry.toUtf8());
         }
         else
         {
-            feature["type"] = "Feature";
-
-            QJsonObject geometry;
-            geometry["type"] = "Point";
-
-            auto latitude = row[indexLatitude];
-            auto longitude = row[indexLongitude];
-
-            QJsonArray coords = QJsonArray {longitude.toDouble(),latitude.toDouble()};
-            geometry["coordinates"] = coords;
-
-            feature["geometry"] = geometry;
+            // The shortest text that reads back to the same coordinate, 17 significant digits would print 37.87 as 37.869999999999997
+            buffer.append("{\"type\":\"Point\",\"coordinates\":[");
+            buffer.append(QByteArray::number(row.at(indexLongitude).toDouble(), 'g', QLocale::FloatingPointShortest));
+            buffer.append(',');
+            buffer.append(QByteArray::number(row.at(indexLatitude).toDouble(), 'g', QLocale::FloatingPointShortest));
+            buffer.append("]}");
         }
 
-
-
-        QJsonObject featureProperties;
-
         // Each column in the table is a feature attribute
+        buffer.append(",\"properties\":{");
+
         for(int i = 0; i<numCol; ++i)
         {
-            auto featureKey = headers[i];
-            auto rowColData = row[i];
+            // The asset type is written last and takes precedence
+            if(headers.at(i) == QLatin1String("type"))
+                continue;
 
-            featureProperties[featureKey] = rowColData;
+            buffer.append(propertyKeys.at(i));
+            this->appendJsonValue(buffer, row.at(i));
+            buffer.append(',');
         }
 
-        featureProperties["type"] = assetType;
-
-        feature["properties"] = featureProperties;
+        buffer.append(typeProperty);
+        buffer.append("}}");
 
-        featuresArray.append(feature);
+        if(buffer.size() >= flushSize && !flush())
+            return -1;
     }
 
-    assetDictionary["features"]=featuresArray;
+    buffer.append("\n]\n}\n");
 
-
-    QFile file(pathToFile);
-    if (!file.open(QFile::WriteOnly | QFile::Text))
-    {
-        err = "Error creating the asset output json file in GeojsonAssetInputWidget";
+    if(!flush())
         return -1;
-    }
-
-    // Write the data to the file
-    QJsonDocument doc(assetDictionary);
-    file.write(doc.toJson());
-    file.close();
 
     return 0;
 }
@@ -193,3 +224,178 @@ int GeoJSONReaderWriter::getIndexOfVal(const QStringList& headersStr, const QStr
 
     return -1;
 }
+
+
+void GeoJSONReaderWriter::appendJsonString(QByteArray& out, const QString& val)
+{
+    static const char hexDigits[] = "0123456789abcdef";
+
+    out.append('"');
+
+    for(auto&& c : val.toUtf8())
+    {
+        switch(c)
+        {
+        case '"': out.append("\\\""); break;
+        case '\\': out.append("\\\\"); break;
+        case '\b': out.append("\\b"); break;
+        case '\f': out.append("\\f"); break;
+        case '\n': out.append("\\n"); break;
+        case '\r': out.append("\\r"); break;
+        case '\t': out.append("\\t"); break;
+        default:
+            if(static_cast<unsigned char>(c) < 0x20)
+            {
+                out.append("\\u00");
+                out.append(hexDigits[(c >> 4) & 0xf]);
+                out.append(hexDigits[c & 0xf]);
+            }
+            else
+                out.append(c);
+        }
+    }
+
+    out.append('"');
+}
+
+
+void GeoJSONReaderWriter::appendJsonValue(QByteArray& out, const QString& val)
+{
+    if(this->isJsonNumber(val))
+        out.append(val.toLatin1());
+    else
+        this->appendJsonString(out, val);
+}
+
+
+bool GeoJSONReaderWriter::isJsonNumber(const QString& val)
+{
+    // -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)?
+    const auto n = val.size();
+    int i = 0;
+
+    auto isDigit = [&](int j) { return j < n && val.at(j) >= QLatin1Char('0') && val.at(j) <= QLatin1Char('9'); };
+
+    if(i < n && val.at(i) == QLatin1Char('-'))
+        ++i;
+
+    if(!isDigit(i))
+        return false;
+
+    if(val.at(i) == QLatin1Char('0'))
+        ++i;
+    else
+        while(isDigit(i))
+            ++i;
+
+    if(i < n && val.at(i) == QLatin1Char('.'))
+    {
+        ++i;
+        if(!isDigit(i))
+            return false;
+        while(isDigit(i))
+            ++i;
+    }
+
+    if(i < n && (val.at(i) == QLatin1Char('e') || val.at(i) == QLatin1Char('E')))
+    {
+        ++i;
+        if(i < n && (val.at(i) == QLatin1Char('+') || val.at(i) == QLatin1Char('-')))
+            ++i;
+        if(!isDigit(i))
+            return false;
+        while(isDigit(i))
+            ++i;
+    }
+
+    return i == n;
+}
+
+
+QStringRef GeoJSONReaderWriter::extractGeometry(const QString& featureJson)
+{
+    // Scans the top level members of the object without building a DOM, tracking nesting and string literals
+    const auto n = featureJson.size();
+
+    int depth = 0;
+    bool inString = false;
+    bool hasCoordinates = false;
+    int keyStart = -1;
+    QStringRef lastKey;
+
+    for(int i = 0; i<n; ++i)
+    {
+        auto c = featureJson.at(i);
+
+        if(inString)
+        {
+            if(c == QLatin1Char('\\'))
+                ++i;
+            else if(c == QLatin1Char('"'))
+            {
+                inString = false;
+                if(depth == 1 && keyStart != -1)
+                    lastKey = featureJson.midRef(keyStart, i - keyStart);
+            }
+            continue;
+        }
+
+        if(c == QLatin1Char('"'))
+        {
+            inString = true;
+            keyStart = (depth == 1 && lastKey.isNull()) ? i + 1 : -1;
+        }
+        else if(c == QLatin1Char('{') || c == QLatin1Char('['))
+        {
+            // The value of a top level member starts here
+            if(depth == 1 && lastKey == QLatin1String("geometry") && c == QLatin1Char('{'))
+            {
+                // Find the matching closing brace
+                int valueDepth = 0;
+                bool valueInString = false;
+                for(int j = i; j<n; ++j)
+                {
+                    auto vc = featureJson.at(j);
+                    if(valueInString)
+                    {
+                        if(vc == QLatin1Char('\\'))
+                            ++j;
+                        else if(vc == QLatin1Char('"'))
+                            valueInString = false;
+                    }
+                    else if(vc == QLatin1Char('"'))
+                        valueInString = true;
+                    else if(vc == QLatin1Char('{') || vc == QLatin1Char('['))
+                        ++valueDepth;
+                    else if(vc == QLatin1Char('}') || vc == QLatin1Char(']'))
+                    {
+                        if(--valueDepth == 0)
+                            return featureJson.midRef(i, j - i + 1);
+                    }
+                }
+
+                return QStringRef();
+            }
+
+            if(depth == 1 && lastKey == QLatin1String("coordinates"))
+                hasCoordinates = true;
+
+            ++depth;
+        }
+        else if(c == QLatin1Char('}') || c == QLatin1Char(']'))
+        {
+            --depth;
+        }
+        else if(c == QLatin1Char(',') && depth == 1)
+        {
+            // Next top level member
+            lastKey = QStringRef();
+        }
+    }
+
+    // The footprint may be a bare geometry object rather than a feature
+    if(hasCoordinates)
+        return featureJson.midRef(0);
+
+    return QStringRef();
+}
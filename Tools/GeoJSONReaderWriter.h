@@ -38,9 +38,11 @@ UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 
 // Written by: Stevan Gavrilovic
 
+#include <QString>
 #include <QVector>
 
-class QString;
+class QByteArray;
+class QIODevice;
 class QStringList;
 
 class GeoJSONReaderWriter
@@ -55,11 +57,30 @@ public:
                         const QString& pathToFile,
                         QString& err);
 
+    // Streams the data as a GeoJson feature collection to an open device, one feature at a time
+    // The first row of data is the header row and is skipped
+    int writeGeoJson(const QVector<QStringList>& data,
+                     const QStringList& headers,
+                     const QString assetType,
+                     QIODevice& device,
+                     QString& err);
+
+    // Appends the value as a JSON string literal
+    void appendJsonString(QByteArray& out, const QString& val);
 
 private:
 
     int getIndexOfVal(const QStringList& headersStr, const QString val);
 
+    // Appends the value unquoted if its text is already a valid JSON number, otherwise as a string
+    void appendJsonValue(QByteArray& out, const QString& val);
+
+    // Returns true if the text is a number in the JSON grammar, e.g., no leading zeros, nan or inf
+    bool isJsonNumber(const QString& val);
+
+    // Returns the raw text of the "geometry" member of a feature json string, or an empty string if there is none
+    QStringRef extractGeometry(const QString& featureJson);
+
 };
 
 #endif // GeoJSONReaderWriter_H
@@ -0,0 +1,500 @@
+/* *****************************************************************************
+Copyright (c) 2016-2021, The Regents of the University of California (Regents).
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those
+of the authors and should not be interpreted as representing official policies,
+either expressed or implied, of the FreeBSD Project.
+
+REGENTS SPECIFICALLY DISCLAIMS ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+THE SOFTWARE AND ACCOMPANYING DOCUMENTATION, IF ANY, PROVIDED HEREUNDER IS
+PROVIDED "AS IS". REGENTS HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+
+*************************************************************************** */
+
+
+#include "HurricaneDatabaseCache.h"
+#include "CSVReaderWriter.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+#include <cstring>
+#include <limits>
+
+namespace {
+
+const char cacheMagic[8] = {'R','2','D','I','B','T','R','C'};
+const quint32 cacheVersion = 1;
+const quint32 byteOrderMark = 0x01020304;
+
+// Separates the values of a track point in the text section of the cache
+const QChar valueSeparator(0x1f);
+
+quint64 alignTo8(const quint64 offset)
+{
+    return (offset + 7) & ~quint64(7);
+}
+
+}
+
+
+HurricaneDatabaseCache::HurricaneDatabaseCache()
+{
+
+}
+
+
+HurricaneDatabaseCache::~HurricaneDatabaseCache()
+{
+    this->close();
+}
+
+
+QString HurricaneDatabaseCache::cacheFilePath(const QString& sourceFilePath)
+{
+    auto cacheDir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+
+    // One cache per source file, named after the hash of its absolute path
+    auto absolutePath = QFileInfo(sourceFilePath).absoluteFilePath();
+    auto pathHash = QCryptographicHash::hash(absolutePath.toUtf8(), QCryptographicHash::Md5).toHex();
+
+    return cacheDir + QDir::separator() + "IBTrACS_" + QString::fromLatin1(pathHash) + ".bin";
+}
+
+
+bool HurricaneDatabaseCache::open(const QString& sourceFilePath, QString& err)
+{
+    this->close();
+
+    QFileInfo sourceInfo(sourceFilePath);
+
+    if(!sourceInfo.exists())
+    {
+        err = "Cannot find the file: " + sourceFilePath + "\nCheck your directory and try again.";
+        return false;
+    }
+
+    auto pathToCache = cacheFilePath(sourceFilePath);
+
+    cacheFile.setFileName(pathToCache);
+
+    // Use the existing cache if it is still valid
+    QString cacheErr;
+    if(this->validate(sourceInfo, cacheErr))
+        return true;
+
+    this->close();
+
+    QDir().mkpath(QFileInfo(pathToCache).absolutePath());
+
+    if(build(sourceFilePath, pathToCache, err) != 0)
+        return false;
+
+    if(!this->validate(sourceInfo, err))
+    {
+        this->close();
+        return false;
+    }
+
+    return true;
+}
+
+
+bool HurricaneDatabaseCache::validate(const QFileInfo& sourceInfo, QString& err)
+{
+    if(!cacheFile.exists() || !cacheFile.open(QIODevice::ReadOnly))
+    {
+        err = "Cannot open the hurricane database cache " + cacheFile.fileName();
+        return false;
+    }
+
+    auto fileSize = cacheFile.size();
+
+    if(fileSize < qint64(sizeof(FileHeader)))
+    {
+        err = "The hurricane database cache " + cacheFile.fileName() + " is incomplete";
+        return false;
+    }
+
+    mappedData = cacheFile.map(0, fileSize);
+
+    if(mappedData == nullptr)
+    {
+        err = "Cannot map the hurricane database cache " + cacheFile.fileName() + " into memory";
+        return false;
+    }
+
+    header = reinterpret_cast<const FileHeader*>(mappedData);
+
+    if(std::memcmp(header->magic, cacheMagic, sizeof(cacheMagic)) != 0 || header->version != cacheVersion || header->byteOrderMark != byteOrderMark)
+    {
+        err = "The hurricane database cache " + cacheFile.fileName() + " is from an incompatible version";
+        return false;
+    }
+
+    if(header->fileSize != quint64(fileSize))
+    {
+        err = "The hurricane database cache " + cacheFile.fileName() + " is incomplete";
+        return false;
+    }
+
+    // The cache is stale if the source file has changed since it was built
+    if(header->sourceSize != sourceInfo.size() || header->sourceModified != sourceInfo.lastModified().toMSecsSinceEpoch())
+    {
+        err = "The hurricane database cache " + cacheFile.fileName() + " is out of date";
+        return false;
+    }
+
+    parameterLabels = this->getString(header->labels).split(valueSeparator);
+
+    auto numStorms = static_cast<int>(header->numStorms);
+
+    stormIndex.clear();
+    stormIndex.reserve(numStorms);
+
+    // If a storm id appears more than once, the first storm with that id is the one that is found
+    for(int i = 0; i<numStorms; ++i)
+    {
+        auto SID = this->getSID(i);
+
+        if(!stormIndex.contains(SID))
+            stormIndex.insert(SID, i);
+    }
+
+    return true;
+}
+
+
+void HurricaneDatabaseCache::close(void)
+{
+    if(mappedData != nullptr)
+        cacheFile.unmap(mappedData);
+
+    mappedData = nullptr;
+    header = nullptr;
+
+    if(cacheFile.isOpen())
+        cacheFile.close();
+
+    parameterLabels.clear();
+    stormIndex.clear();
+}
+
+
+bool HurricaneDatabaseCache::isOpen(void) const
+{
+    return header != nullptr && !parameterLabels.isEmpty();
+}
+
+
+int HurricaneDatabaseCache::build(const QString& sourceFilePath, const QString& cacheFilePath, QString& err)
+{
+    QFileInfo sourceInfo(sourceFilePath);
+
+    QStringList labels;
+
+    int indexSID = -1;
+    int indexName = -1;
+    int indexSeason = -1;
+    int indexLandfall = -1;
+    int indexLat = -1;
+    int indexLon = -1;
+
+    QVector<StormRecord> storms;
+    QVector<double> latitudes;
+    QVector<double> longitudes;
+    QVector<StringRef> rows;
+    QByteArray text;
+
+    auto appendString = [&text](const QString& str) -> StringRef
+    {
+        auto utf8 = str.toUtf8();
+
+        StringRef ref;
+        ref.offset = text.size();
+        ref.length = utf8.size();
+
+        text.append(utf8);
+
+        return ref;
+    };
+
+    auto toDouble = [](const QString& str) -> double
+    {
+        bool ok = false;
+        auto val = str.toDouble(&ok);
+
+        return ok ? val : std::numeric_limits<double>::quiet_NaN();
+    };
+
+    QString currSID;
+
+    auto callback = [&](int row, const QStringList& record) -> bool
+    {
+        // Get the header information to populate the fields
+        if(row == 0)
+        {
+            labels = record;
+
+            indexSID = labels.indexOf("SID");
+            indexName = labels.indexOf("NAME");
+            indexSeason = labels.indexOf("SEASON");
+            indexLandfall = labels.indexOf("DIST2LAND");
+            indexLat = labels.indexOf("LAT");
+            indexLon = labels.indexOf("LON");
+
+            if(indexSID == -1 || indexName == -1 || indexSeason == -1 || indexLandfall == -1 || indexLat == -1 || indexLon == -1)
+            {
+                err = "Could not find the required column indexes in the data file";
+                return false;
+            }
+
+            return true;
+        }
+
+        // The second row contains the units information
+        if(row == 1)
+            return true;
+
+        if(record.size() != labels.size())
+        {
+            err = "Error, inconsistency in the data in the row and number of columns";
+            return false;
+        }
+
+        // The hurricanes come in one long list, a new hurricane begins when the storm id changes
+        auto SID = record.at(indexSID);
+
+        if(storms.isEmpty() || SID.compare(currSID) != 0)
+        {
+            StormRecord storm;
+            storm.SID = appendString(SID);
+            storm.name = appendString(record.at(indexName));
+            storm.season = appendString(record.at(indexSeason));
+            storm.firstPoint = rows.size();
+            storm.numPoints = 0;
+            storm.indexLandfall = -1;
+
+            storms.push_back(storm);
+
+            currSID = SID;
+        }
+
+        auto& storm = storms.last();
+
+        // Not all hurricanes will make landfall, if the distance to land is 0, then this is the first landfall
+        if(storm.indexLandfall == -1 && record.at(indexLandfall).compare("0") == 0)
+            storm.indexLandfall = storm.numPoints;
+
+        latitudes.push_back(toDouble(record.at(indexLat)));
+        longitudes.push_back(toDouble(record.at(indexLon)));
+
+        rows.push_back(appendString(record.join(valueSeparator)));
+
+        ++storm.numPoints;
+
+        return true;
+    };
+
+    CSVReaderWriter csvTool;
+
+    auto numRows = csvTool.parseCSVFile(sourceFilePath, callback, err);
+
+    if(numRows == -1 || !err.isEmpty())
+        return -1;
+
+    if(storms.isEmpty())
+    {
+        err = "Hurricane data is empty";
+        return -1;
+    }
+
+    // Lay out the sections of the file, each one aligned to 8 bytes so that it can be read in place from the mapped file
+    FileHeader fileHeader;
+    std::memset(&fileHeader, 0, sizeof(FileHeader));
+    std::memcpy(fileHeader.magic, cacheMagic, sizeof(cacheMagic));
+
+    fileHeader.version = cacheVersion;
+    fileHeader.byteOrderMark = byteOrderMark;
+    fileHeader.sourceSize = sourceInfo.size();
+    fileHeader.sourceModified = sourceInfo.lastModified().toMSecsSinceEpoch();
+    fileHeader.numStorms = storms.size();
+    fileHeader.numPoints = rows.size();
+    fileHeader.labels = appendString(labels.join(valueSeparator));
+
+    fileHeader.stormsOffset = alignTo8(sizeof(FileHeader));
+    fileHeader.latitudesOffset = alignTo8(fileHeader.stormsOffset + storms.size()*sizeof(StormRecord));
+    fileHeader.longitudesOffset = alignTo8(fileHeader.latitudesOffset + latitudes.size()*sizeof(double));
+    fileHeader.rowsOffset = alignTo8(fileHeader.longitudesOffset + longitudes.size()*sizeof(double));
+    fileHeader.textOffset = alignTo8(fileHeader.rowsOffset + rows.size()*sizeof(StringRef));
+    fileHeader.fileSize = fileHeader.textOffset + text.size();
+
+    // The file is written to a temporary file first, so that an interrupted build does not leave a partial cache behind
+    QSaveFile file(cacheFilePath);
+
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        err = "Cannot create the file: " + cacheFilePath + "\n" +"Check your directory and try again.";
+        return -1;
+    }
+
+    auto writeSection = [&file](const quint64 offset, const char* data, const qint64 size)
+    {
+        // Pad up to the beginning of the section
+        auto padding = qint64(offset) - file.pos();
+        if(padding > 0)
+            file.write(QByteArray(padding, '\0'));
+
+        file.write(data, size);
+    };
+
+    writeSection(0, reinterpret_cast<const char*>(&fileHeader), sizeof(FileHeader));
+    writeSection(fileHeader.stormsOffset, reinterpret_cast<const char*>(storms.constData()), storms.size()*sizeof(StormRecord));
+    writeSection(fileHeader.latitudesOffset, reinterpret_cast<const char*>(latitudes.constData()), latitudes.size()*sizeof(double));
+    writeSection(fileHeader.longitudesOffset, reinterpret_cast<const char*>(longitudes.constData()), longitudes.size()*sizeof(double));
+    writeSection(fileHeader.rowsOffset, reinterpret_cast<const char*>(rows.constData()), rows.size()*sizeof(StringRef));
+    writeSection(fileHeader.textOffset, text.constData(), text.size());
+
+    if(!file.commit())
+    {
+        err = "Error writing the hurricane database cache " + cacheFilePath + ": " + file.errorString();
+        return -1;
+    }
+
+    return 0;
+}
+
+
+QString HurricaneDatabaseCache::getString(const StringRef& ref) const
+{
+    auto data = reinterpret_cast<const char*>(mappedData + header->textOffset + ref.offset);
+
+    return QString::fromUtf8(data, static_cast<int>(ref.length));
+}
+
+
+const HurricaneDatabaseCache::StormRecord& HurricaneDatabaseCache::stormRecord(const int storm) const
+{
+    auto records = reinterpret_cast<const StormRecord*>(mappedData + header->stormsOffset);
+
+    return records[storm];
+}
+
+
+QStringList HurricaneDatabaseCache::getParameterLabels(void) const
+{
+    return parameterLabels;
+}
+
+
+int HurricaneDatabaseCache::numStorms(void) const
+{
+    if(header == nullptr)
+        return 0;
+
+    return static_cast<int>(header->numStorms);
+}
+
+
+int HurricaneDatabaseCache::indexOfStorm(const QString& SID) const
+{
+    return stormIndex.value(SID, -1);
+}
+
+
+QString HurricaneDatabaseCache::getSID(const int storm) const
+{
+    return this->getString(this->stormRecord(storm).SID);
+}
+
+
+QString HurricaneDatabaseCache::getName(const int storm) const
+{
+    return this->getString(this->stormRecord(storm).name);
+}
+
+
+QString HurricaneDatabaseCache::getSeason(const int storm) const
+{
+    return this->getString(this->stormRecord(storm).season);
+}
+
+
+int HurricaneDatabaseCache::numTrackPoints(const int storm) const
+{
+    return static_cast<int>(this->stormRecord(storm).numPoints);
+}
+
+
+const double* HurricaneDatabaseCache::trackLatitudes(const int storm) const
+{
+    auto latitudes = reinterpret_cast<const double*>(mappedData + header->latitudesOffset);
+
+    return latitudes + this->stormRecord(storm).firstPoint;
+}
+
+
+const double* HurricaneDatabaseCache::trackLongitudes(const int storm) const
+{
+    auto longitudes = reinterpret_cast<const double*>(mappedData + header->longitudesOffset);
+
+    return longitudes + this->stormRecord(storm).firstPoint;
+}
+
+
+HurricaneObject HurricaneDatabaseCache::getHurricane(const int storm) const
+{
+    HurricaneObject hurricane;
+
+    if(storm < 0 || storm >= this->numStorms())
+        return hurricane;
+
+    const auto& record = this->stormRecord(storm);
+
+    auto rows = reinterpret_cast<const StringRef*>(mappedData + header->rowsOffset);
+
+    hurricane.parameterLabels = parameterLabels;
+    hurricane.name = this->getString(record.name);
+    hurricane.SID = this->getString(record.SID);
+    hurricane.season = this->getString(record.season);
+
+    hurricane.hurricaneData.reserve(static_cast<int>(record.numPoints));
+
+    for(quint64 i = 0; i<record.numPoints; ++i)
+        hurricane.push_back(this->getString(rows[record.firstPoint + i]).split(valueSeparator));
+
+    if(record.indexLandfall != -1)
+    {
+        hurricane.indexLandfall = static_cast<int>(record.indexLandfall);
+        hurricane.landfallData = hurricane.hurricaneData.at(hurricane.indexLandfall);
+    }
+
+    return hurricane;
+}
@@ -0,0 +1,151 @@
+#ifndef HURRICANEDATABASECACHE_H
+#define HURRICANEDATABASECACHE_H
+/* *****************************************************************************
+Copyright (c) 2016-2021, The Regents of the University of California (Regents).
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those
+of the authors and should not be interpreted as representing official policies,
+either expressed or implied, of the FreeBSD Project.
+
+REGENTS SPECIFICALLY DISCLAIMS ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+THE SOFTWARE AND ACCOMPANYING DOCUMENTATION, IF ANY, PROVIDED HEREUNDER IS
+PROVIDED "AS IS". REGENTS HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+
+*************************************************************************** */
+
+
+#include "HurricaneObject.h"
+
+#include <QFile>
+#include <QHash>
+#include <QString>
+#include <QStringList>
+
+class QFileInfo;
+
+// Binary cache of the IBTrACS hurricane database, so that the csv only needs to be parsed once
+//
+// The cache file is memory mapped when it is opened. It holds:
+//  - the column labels of the csv
+//  - a table of the storms, each with its storm id, name, season, range of track points and first landfall
+//  - the latitude and longitude of every track point as doubles
+//  - the raw values of every track point, decoded into a HurricaneObject only when a storm is requested
+//
+// The cache is keyed on the size and the modification time of the source csv, and is rebuilt when either changes
+class HurricaneDatabaseCache
+{
+public:
+    HurricaneDatabaseCache();
+    ~HurricaneDatabaseCache();
+
+    // Opens the cache of the source file, building it first if it does not exist or is out of date
+    // Returns false if the cache could not be opened, with the reason in err
+    bool open(const QString& sourceFilePath, QString& err);
+
+    void close(void);
+
+    bool isOpen(void) const;
+
+    // Returns the location of the cache file for the source file
+    static QString cacheFilePath(const QString& sourceFilePath);
+
+    // Parses the source csv and writes the cache file, returns 0 on success
+    static int build(const QString& sourceFilePath, const QString& cacheFilePath, QString& err);
+
+    QStringList getParameterLabels(void) const;
+
+    int numStorms(void) const;
+
+    // Returns the index of the storm with the given storm id, or -1 if it is not in the database
+    int indexOfStorm(const QString& SID) const;
+
+    QString getSID(const int storm) const;
+    QString getName(const int storm) const;
+    QString getSeason(const int storm) const;
+
+    int numTrackPoints(const int storm) const;
+
+    // The track coordinates from the LAT and LON columns, a value that could not be parsed is stored as NaN
+    const double* trackLatitudes(const int storm) const;
+    const double* trackLongitudes(const int storm) const;
+
+    // Decodes the full track data of a storm
+    HurricaneObject getHurricane(const int storm) const;
+
+private:
+
+    struct StringRef
+    {
+        quint64 offset;
+        quint64 length;
+    };
+
+    struct FileHeader
+    {
+        char magic[8];
+        quint32 version;
+        quint32 byteOrderMark;
+        qint64 sourceSize;
+        qint64 sourceModified;
+        quint64 fileSize;
+        quint64 numStorms;
+        quint64 numPoints;
+        quint64 stormsOffset;
+        quint64 latitudesOffset;
+        quint64 longitudesOffset;
+        quint64 rowsOffset;
+        quint64 textOffset;
+        StringRef labels;
+    };
+
+    struct StormRecord
+    {
+        StringRef SID;
+        StringRef name;
+        StringRef season;
+        quint64 firstPoint;
+        quint64 numPoints;
+        qint64 indexLandfall;
+    };
+
+    bool validate(const QFileInfo& sourceInfo, QString& err);
+
+    QString getString(const StringRef& ref) const;
+
+    const StormRecord& stormRecord(const int storm) const;
+
+    QFile cacheFile;
+
+    uchar* mappedData = nullptr;
+
+    const FileHeader* header = nullptr;
+
+    QStringList parameterLabels;
+
+    QHash<QString, int> stormIndex;
+};
+
+#endif // HURRICANEDATABASECACHE_H
@@ -36,12 +36,14 @@ UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 
 // Written by: Stevan Gavrilovic
 
+#include "AssetInputDelegate.h"
 #include "CSVReaderWriter.h"
 #include "ComponentDatabaseManager.h"
 #include "GeneralInformationWidgetR2D.h"
 #include "MainWindowWorkflowApp.h"
 #include "Pelicun3PostProcessor.h"
 #include "REmpiricalProbabilityDistribution.h"
+#include "ResultsTableModel.h"
 #include "TablePrinter.h"
 #include "TableNumberItem.h"
 #include "VisualizationWidget.h"
@@ -70,6 +72,7 @@ UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 #include <QStackedBarSeries>
 #include <QStringList>
 #include <QTabWidget>
+#include <QTableView>
 #include <QTableWidget>
 #include <QTextCursor>
 #include <QTextTable>
@@ -120,12 +123,32 @@ Pelicun3PostProcessor::Pelicun3PostProcessor(QWidget * parent) : SC_ResultsWidge
 //    totalAndFootNoteLayout->addStretch();
 //    totalAndFootNoteWidget->setSizePolicy(QSizePolicy::Minimum, QSizePolicy::Minimum);
 
-//    summaryDock = new QDockWidget("Estimated Regional Totals",this);
-//    summaryDock->setObjectName("SummaryDock");
-//    summaryDock->setWidget(totalAndFootNoteWidget);
-//    summaryDock->setSizePolicy(QSizePolicy::Minimum, QSizePolicy::Minimum);
-//    summaryDock->setMaximumHeight(200);
-//    mainWindow->addDockWidget(Qt::RightDockWidgetArea, summaryDock);
+    // Totals of the results of all of the assets, or of a subset of them, for each asset type
+    QWidget* summaryWidget = new QWidget(mainWindow);
+    QVBoxLayout* summaryLayout = new QVBoxLayout(summaryWidget);
+
+    QHBoxLayout* subsetLayout = new QHBoxLayout();
+    auto subsetLabel = new QLabel("Assets:", summaryWidget);
+    subsetLineEdit = new AssetInputDelegate();
+    subsetLineEdit->setToolTip("The assets that are included in the totals, leave empty to include all of the assets");
+    connect(subsetLineEdit, &QLineEdit::editingFinished, this, &Pelicun3PostProcessor::handleSubsetSelection);
+    subsetLayout->addWidget(subsetLabel);
+    subsetLayout->addWidget(subsetLineEdit);
+
+    totalsTableWidget = new QTableWidget(summaryWidget);
+    totalsTableWidget->setColumnCount(7);
+    totalsTableWidget->setHorizontalHeaderLabels({"Asset Type","Result","Total","Mean","Median","Min","Max"});
+    totalsTableWidget->verticalHeader()->setVisible(false);
+    totalsTableWidget->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+    totalsTableWidget->setEditTriggers(QAbstractItemView::NoEditTriggers);
+
+    summaryLayout->addLayout(subsetLayout);
+    summaryLayout->addWidget(totalsTableWidget);
+
+    summaryDock = new QDockWidget("Estimated Regional Totals",mainWindow);
+    summaryDock->setObjectName("SummaryDock");
+    summaryDock->setWidget(summaryWidget);
+    mainWindow->addDockWidget(Qt::RightDockWidgetArea, summaryDock);
 
     mainWindow->show();
     layout->addWidget(mainWindow);
@@ -181,10 +204,6 @@ int Pelicun3PostProcessor::processResults(QString &outputFile, QString &dirName,
             features = jsonObject["features"].toArray();
         }
 
-//        totalRepairCostValue += calculateTotal(features, "mean repair_cost-");
-//        totalRepairTimeSequentialValue += calculateTotal(features, "mean repair_time-sequential");
-//        totalRepairTimeParallelValue += calculateTotal(features, "mean repair_time-parallel");
-
         //Dock widget for this type
         QDockWidget* typeDockWidget = new QDockWidget(type,mainWindow);
         typeDockWidget->setObjectName(type + "TableDock");
@@ -194,7 +213,9 @@ int Pelicun3PostProcessor::processResults(QString &outputFile, QString &dirName,
 
         QVBoxLayout* typetableWidgetLayout = new QVBoxLayout(typetableWidget);
 
-        QTableWidget* typeResultsTableWidget = new QTableWidget(typeDockWidget);
+        QTableView* typeResultsTableWidget = new QTableView(typeDockWidget);
+        ResultsTableModel* typeResultsTableModel = new ResultsTableModel(typeResultsTableWidget);
+        typeResultsTableWidget->setModel(typeResultsTableModel);
         typeResultsTableWidget->verticalHeader()->setVisible(false);
         typeResultsTableWidget->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
 
@@ -208,6 +229,7 @@ int Pelicun3PostProcessor::processResults(QString &outputFile, QString &dirName,
 
         typeResultsTableWidget->setItemDelegate(new DoubleDelegate(typeDockWidget,3));
         tableList.append(typeResultsTableWidget);
+        tableTypes.append(type);
         // Combo box to select how to sort the table
         QHBoxLayout* comboLayout = new QHBoxLayout();
 
@@ -243,7 +265,7 @@ int Pelicun3PostProcessor::processResults(QString &outputFile, QString &dirName,
         typetableWidgetLayout->addStretch(0);
 
 //        QStringList extractAttributes = {"AIM_id","mean repair_cost-","mean repair_time-parallel","mean repair_time-sequential", "highest_DMG"};
-        extractDataAddToTable(features, extractAttributes,typeResultsTableWidget, comboBoxHeadings);
+        extractDataAddToTable(features, extractAttributes,typeResultsTableModel, comboBoxHeadings, type);
         dockList.append(typeDockWidget);
 
         typeDockWidget->setWidget(typetableWidget);
@@ -253,9 +275,8 @@ int Pelicun3PostProcessor::processResults(QString &outputFile, QString &dirName,
         mainWindow->addDockWidget(Qt::RightDockWidgetArea, typeDockWidget);
 
     }
-//    totalRepairCostValueLabel->setText(QString::number(totalRepairCostValue));
-//    totalRepairTimeSequentialValueLabel->setText(QString::number(totalRepairTimeSequentialValue));
-//    totalRepairTimeParallelValueLabel->setText(QString::number(totalRepairTimeParallelValue));
+    this->updateTotalsTable();
+
     // tabify dock widgets
     if (dockList.count()>1){
         QDockWidget* base = dockList.at(0);
@@ -299,7 +320,7 @@ int Pelicun3PostProcessor::processResults(QString &outputFile, QString &dirName,
         }
         viewMenu = resultsMenu->addMenu("&" + assetType);
         viewMenu->addAction(tr("&Restore"), this, &Pelicun3PostProcessor::restoreUI);
-//        viewMenu->addAction(summaryDock->toggleViewAction());
+        viewMenu->addAction(summaryDock->toggleViewAction());
         viewMenu->addAction(mapViewDock->toggleViewAction());
         for (int dock_i = 0; dock_i<dockList.count(); dock_i++){
             viewMenu->addAction(dockList.at(dock_i)->toggleViewAction());
@@ -315,48 +336,149 @@ int Pelicun3PostProcessor::processResults(QString &outputFile, QString &dirName,
 
 }
 
-int Pelicun3PostProcessor::extractDataAddToTable(QJsonArray& features, QStringList& attributes, QTableWidget* table, QStringList headings){
-    QVector<QVector<double>> result(features.count(), QVector<double> (attributes.count(), 0.0));
-    table->setColumnCount(headings.size());
-    table->setHorizontalHeaderLabels(headings);
-    table->setRowCount(features.count());
+int Pelicun3PostProcessor::extractDataAddToTable(QJsonArray& features, QStringList& attributes, ResultsTableModel* model, QStringList headings, const QString& type){
+    // The values go into a typed column store, the asset ids are typed by their values and the results are stored as doubles
+    QVector<ColumnarTable::ColumnType> columnTypes(attributes.count(), ColumnarTable::DoubleColumn);
+    QStringList aggregateColumns;
+    for (int n = 0; n < attributes.count(); n++){
+        if (attributes.at(n).compare("AIM_id")==0)
+            columnTypes[n] = ColumnarTable::Int64Column;
+        else
+            aggregateColumns.append(headings.at(n));
+    }
+
+    // The results are aggregated in the same pass, under the type of the assets and the names in the table header so that a subset can be recomputed from the table
+    resultsAggregator.addGroup(type, aggregateColumns);
+    QVector<double> aggregateRow(aggregateColumns.count());
+
+    ColumnarTable table;
+    table.setHeader(headings, columnTypes);
+    table.reserve(features.count());
+
+    QVector<QVariant> row(attributes.count());
     for (int m = 0; m < features.count(); m++){
-        QJsonObject ft = features.at(m).toObject();
-        QJsonObject properties = ft["properties"].toObject();
+        QJsonObject properties = features.at(m).toObject()["properties"].toObject();
+        int aggregateIndex = 0;
         for (int n = 0; n < attributes.count(); n++){
-            QString attri = attributes.at(n);
-            if (!properties.contains(attri)){
+            const QString& attri = attributes.at(n);
+            auto value = properties.value(attri);
+            if (value.isUndefined()){
                 this->errorMessage(attri + QString(" dose not exist in R2D_results.geojson"));
+                resultsAggregator.addGroup(type, aggregateColumns);
                 return -1;
             }
-            else{
-                if (attri.compare("AIM_id")==0){
-                    auto item = new TableNumberItem(properties[attri].toString());
-                    table->setItem(m, n, item);
-                } else {
-                    result[m][n] = properties[attri].toDouble();
-                    auto item = new TableNumberItem(QString::number(result[m][n]));
-                    table->setItem(m, n, item);
-                }
+            if (columnTypes.at(n) == ColumnarTable::Int64Column){
+                row[n] = value.toVariant().toString();
+            } else {
+                auto result = value.toDouble();
+                row[n] = result;
+                aggregateRow[aggregateIndex++] = result;
             }
         }
+        table.appendRow(row);
+        resultsAggregator.addRow(type, aggregateRow);
     }
+
+    model->populateData(std::move(table));
+
     return 0;
 }
 
-double Pelicun3PostProcessor::calculateTotal(QJsonArray& featArray, QString field){
-    double result = 0.0;
-    for (auto ft : featArray){
-        QJsonObject properties = ft.toObject()["properties"].toObject();
-        if (!properties.contains(field)){
-            this->errorMessage(field + QString(" dose not exist in R2D_results.geojson"));
-            return 0.0;
+void Pelicun3PostProcessor::processResultsSubset(const ComponentIDSet& selectedComponentIDs)
+{
+    selectedRows.clear();
+
+    for (int i = 0; i < tableList.count(); i++){
+        auto model = dynamic_cast<ResultsTableModel*>(tableList.at(i)->model());
+        if (model == nullptr)
+            continue;
+
+        const auto& table = model->getTable();
+        const auto& type = tableTypes.at(i);
+
+        QVector<int> rows;
+        if (!selectedComponentIDs.empty()){
+            auto idIndex = table.columnIndex("AIM_id");
+            if (idIndex == -1){
+                this->errorMessage("Could not find the AIM_id column in the results of " + type);
+                return;
+            }
+
+            for (int row = 0; row < table.rowCount(); row++){
+                bool OK = false;
+                auto id = table.int64Value(row, idIndex, &OK);
+                if (OK && selectedComponentIDs.contains(static_cast<int>(id)))
+                    rows.append(row);
+            }
         }
-        else{
-            result += properties[field].toDouble();
+
+        selectedRows.append(rows);
+
+        // None of the selected assets are of this type
+        if (!selectedComponentIDs.empty() && rows.isEmpty()){
+            resultsAggregator.addGroup(type, resultsAggregator.getColumns(type));
+            continue;
+        }
+
+        QString err;
+        if (resultsAggregator.addTable(type, table, err, rows) != 0){
+            this->errorMessage(err);
+            return;
+        }
+    }
+
+    this->updateTotalsTable();
+}
+
+
+void Pelicun3PostProcessor::updateTotalsTable(void)
+{
+    totalsTableWidget->setRowCount(0);
+
+    for (int i = 0; i < tableList.count(); i++){
+        auto model = dynamic_cast<ResultsTableModel*>(tableList.at(i)->model());
+        if (model == nullptr)
+            continue;
+
+        const auto& type = tableTypes.at(i);
+        auto rows = selectedRows.value(i);
+
+        for (auto&& column : resultsAggregator.getColumns(type)){
+            auto aggregate = resultsAggregator.getAggregate(type, column);
+
+            auto totalsRow = totalsTableWidget->rowCount();
+            totalsTableWidget->insertRow(totalsRow);
+            totalsTableWidget->setItem(totalsRow, 0, new QTableWidgetItem(type));
+            totalsTableWidget->setItem(totalsRow, 1, new QTableWidgetItem(column));
+
+            // No values of this result in the selected assets
+            if (aggregate.count == 0)
+                continue;
+
+            QString err;
+            auto median = ResultsAggregator::getQuantile(model->getTable(), column, 0.5, err, rows);
+
+            QVector<double> values = {aggregate.total, aggregate.mean(), median, aggregate.min, aggregate.max};
+            for (int k = 0; k < values.size(); k++)
+                totalsTableWidget->setItem(totalsRow, k+2, new QTableWidgetItem(QString::number(values.at(k))));
         }
     }
-    return result;
+}
+
+
+void Pelicun3PostProcessor::handleSubsetSelection(void)
+{
+    try
+    {
+        subsetLineEdit->selectComponents();
+    }
+    catch (const QString msg)
+    {
+        this->errorMessage(msg);
+        return;
+    }
+
+    this->processResultsSubset(subsetLineEdit->getSelectedComponentIDs());
 }
 
 
@@ -541,10 +663,16 @@ void Pelicun3PostProcessor::clear(void)
 {
 
     for (int i = 0; i < tableList.count(); i++){
-        QTableWidget* parentWidget = tableList.at(i);
-        parentWidget->clear();
+        auto model = dynamic_cast<ResultsTableModel*>(tableList.at(i)->model());
+        if(model)
+            model->clear();
     }
     tableList.clear();
+    tableTypes.clear();
+    selectedRows.clear();
+    resultsAggregator.clear();
+    totalsTableWidget->setRowCount(0);
+    subsetLineEdit->clear();
     for (int i = 0; i < dockList.count(); i++){
         QDockWidget* parentWidget = dockList.at(i);
         qDeleteAll(parentWidget->findChildren<QWidget*>("", Qt::FindDirectChildrenOnly));
@@ -47,13 +47,17 @@ UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 #include <QJsonArray>
 
 #include <memory>
-#include <set>
+#include "ComponentIDSet.h"
+#include "ResultsAggregator.h"
 
 class REmpiricalProbabilityDistribution;
 class VisualizationWidget;
 
 class QDockWidget;
 class QTableWidget;
+class QTableView;
+class ResultsTableModel;
+class AssetInputDelegate;
 class QGridLayout;
 class QLabel;
 class QComboBox;
@@ -112,7 +116,8 @@ public:
         return val;
     }
 
-    void processResultsSubset(const std::set<int>& selectedComponentIDs);
+    // Recomputes the totals for the given assets from the loaded results tables, all of the assets are used if the set is empty
+    void processResultsSubset(const ComponentIDSet& selectedComponentIDs);
 
     void setCurrentlyViewable(bool status);
 
@@ -132,13 +137,16 @@ private slots:
 
     void restoreUI(void);
 
+    void handleSubsetSelection(void);
+
 protected:
 
     void showEvent(QShowEvent *e);
 
 private:
 
-    double calculateTotal(QJsonArray& featArray, QString field);
+    // Fills the totals table from the aggregates of each asset type
+    void updateTotalsTable(void);
 
     QString outputFilePath;
 
@@ -159,13 +167,15 @@ private:
 
 
     QDockWidget* mapViewDock;
-//    QDockWidget* summaryDock;
+    QDockWidget* summaryDock;
+    QTableWidget* totalsTableWidget;
+    AssetInputDelegate* subsetLineEdit;
 
     QWidget *tableWidget;
     QVBoxLayout* layout;
 
     QList<QDockWidget*> dockList;
-    QList<QTableWidget*> tableList;
+    QList<QTableView*> tableList;
 
     VisualizationWidget* theVisualizationWidget;
 
@@ -176,7 +186,15 @@ private:
     QGraphicsView* mapViewMainWidget;
 
 
-    int extractDataAddToTable(QJsonArray& features, QStringList& attributes, QTableWidget* table, QStringList headings);
+    int extractDataAddToTable(QJsonArray& features, QStringList& attributes, ResultsTableModel* model, QStringList headings, const QString& type);
+
+    ResultsAggregator resultsAggregator;
+
+    // The asset type of each table in the table list, which is also its group in the aggregates
+    QStringList tableTypes;
+
+    // The rows of each table that are in the selected subset, empty if all of the assets are used
+    QVector<QVector<int>> selectedRows;
 
     QByteArray uiState;
 
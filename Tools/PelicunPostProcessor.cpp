@@ -310,6 +310,8 @@ void PelicunPostProcessor::importResults(const QString& pathToResults)
      if(!errMsg.isEmpty())
         throw errMsg;
 
+    this->buildDVRowIndex();
+
     EDPdata = csvTool.parseCSVFile(pathToBuildings + QDir::separator() + EDPreultsSheet,errMsg);
     if(!errMsg.isEmpty())
         throw errMsg;
@@ -848,7 +850,29 @@ int PelicunPostProcessor::printToPDF(const QString& outputPath)
 }
 
 
-void PelicunPostProcessor::processResultsSubset(const std::set<int>& selectedComponentIDs)
+void PelicunPostProcessor::buildDVRowIndex(void)
+{
+    DVRowIndex.clear();
+    DVRowIndex.reserve(DVdata.size());
+
+    for(int i = numHeaderRows; i<DVdata.size(); ++i)
+    {
+        const auto& row = DVdata.at(i);
+
+        if(row.isEmpty())
+            continue;
+
+        bool OK = false;
+        auto assetID = row.at(0).toInt(&OK);
+
+        // If an id is repeated, the first row with that id is used
+        if(OK && !DVRowIndex.contains(assetID))
+            DVRowIndex.insert(assetID, i);
+    }
+}
+
+
+void PelicunPostProcessor::processResultsSubset(const ComponentIDSet& selectedComponentIDs)
 {
 
     if(selectedComponentIDs.empty())
@@ -871,6 +895,7 @@ void PelicunPostProcessor::processResultsSubset(const std::set<int>& selectedCom
     auto lastID = objectToInt(DVdata.last().at(0));
 
     QVector<QStringList> DVsubset(&DVdata[0],&DVdata[numHeaderRows]);
+    DVsubset.reserve(numHeaderRows + static_cast<int>(selectedComponentIDs.size()));
 
     for(auto&& id : selectedComponentIDs)
     {
@@ -881,26 +906,15 @@ void PelicunPostProcessor::processResultsSubset(const std::set<int>& selectedCom
             throw msg;
         }
 
-        auto found = false;
-        for(int i = numHeaderRows; i<DVdata.size(); ++i)
-        {
-            auto inputRow = DVdata.at(i);
+        auto row = DVRowIndex.value(id, -1);
 
-            auto buildingID = objectToInt(inputRow.at(0));
-
-            if(id == buildingID)
-            {
-                DVsubset << inputRow;
-                found = true;
-                break;
-            }
-        }
-
-        if(!found)
+        if(row == -1)
         {
             QString msg = "ID " + QString::number(id) + " cannot be found in the results";
             throw msg;
         }
+
+        DVsubset << DVdata.at(row);
     }
 
     this->processDVResults(DVsubset);
@@ -1351,6 +1365,7 @@ void PelicunPostProcessor::clear(void)
 {
     DMdata.clear();
     DVdata.clear();
+    DVRowIndex.clear();
     EDPdata.clear();
     if(!IMdata.isEmpty() && IMdata.size()>numHeaderRows)
         siteResponseTableWidget->clear();
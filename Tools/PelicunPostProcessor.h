@@ -43,10 +43,11 @@ UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 #include "SimCenterMapcanvasWidget.h"
 
 #include <QString>
+#include <QHash>
 #include <QMainWindow>
 
 #include <memory>
-#include <set>
+#include "ComponentIDSet.h"
 
 class REmpiricalProbabilityDistribution;
 class VisualizationWidget;
@@ -113,7 +114,7 @@ public:
         return val;
     }
 
-    void processResultsSubset(const std::set<int>& selectedComponentIDs);
+    void processResultsSubset(const ComponentIDSet& selectedComponentIDs);
 
     void setCurrentlyViewable(bool status);
 
@@ -137,8 +138,14 @@ private:
 
     int processDVResults(const QVector<QStringList>& DVResults);
 
+    // Maps the asset ids in the first column of the DV results to their row in DVdata
+    void buildDVRowIndex(void);
+
     QVector<QStringList> DMdata;
     QVector<QStringList> DVdata;
+
+    // Asset id to row of DVdata, built once when the results are imported
+    QHash<int, int> DVRowIndex;
     QVector<QStringList> EDPdata;
     QVector<QStringList> IMdata;
 
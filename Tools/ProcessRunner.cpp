@@ -0,0 +1,234 @@
+/* *****************************************************************************
+Copyright (c) 2016-2021, The Regents of the University of California (Regents).
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those
+of the authors and should not be interpreted as representing official policies,
+either expressed or implied, of the FreeBSD Project.
+
+REGENTS SPECIFICALLY DISCLAIMS ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+THE SOFTWARE AND ACCOMPANYING DOCUMENTATION, IF ANY, PROVIDED HEREUNDER IS
+PROVIDED "AS IS". REGENTS HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+
+*************************************************************************** */
+
+
+#include "ProcessRunner.h"
+
+#include <QTimer>
+
+ProcessRunner::ProcessRunner(QObject *parent) : QObject(parent)
+{
+    process = new QProcess(this);
+
+    progressPattern = QRegularExpression("^\\s*PROGRESS\\s*[:=]?\\s*(\\d+(?:\\.\\d+)?)\\s*%?\\s*(.*)$", QRegularExpression::CaseInsensitiveOption);
+
+    killTimer = new QTimer(this);
+    killTimer->setSingleShot(true);
+    killTimer->setInterval(5000);
+
+    connect(killTimer, &QTimer::timeout, process, &QProcess::kill);
+
+    connect(process, &QProcess::started, this, &ProcessRunner::started);
+    connect(process, &QProcess::readyReadStandardOutput, this, &ProcessRunner::handleStandardOutput);
+    connect(process, &QProcess::readyReadStandardError, this, &ProcessRunner::handleStandardError);
+    connect(process, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished), this, &ProcessRunner::handleFinished);
+    connect(process, &QProcess::errorOccurred, this, &ProcessRunner::handleError);
+}
+
+
+ProcessRunner::~ProcessRunner()
+{
+    // Do not leave the backend running once the widget that started it is gone
+    if(this->isRunning())
+    {
+        process->disconnect(this);
+        process->kill();
+        process->waitForFinished(1000);
+    }
+}
+
+
+bool ProcessRunner::start(const QString& program, const QStringList& arguments, const QString& workingDirectory)
+{
+    if(this->isRunning())
+        return false;
+
+    cancelled = false;
+    outputBuffer.clear();
+    errorBuffer.clear();
+
+    if(!workingDirectory.isEmpty())
+        process->setWorkingDirectory(workingDirectory);
+
+    process->start(program, arguments);
+
+    return true;
+}
+
+
+bool ProcessRunner::isRunning(void) const
+{
+    return process->state() != QProcess::NotRunning;
+}
+
+
+bool ProcessRunner::wasCancelled(void) const
+{
+    return cancelled;
+}
+
+
+void ProcessRunner::setProgressPattern(const QRegularExpression& pattern)
+{
+    progressPattern = pattern;
+}
+
+
+void ProcessRunner::setTerminateTimeout(const int msec)
+{
+    killTimer->setInterval(msec);
+}
+
+
+void ProcessRunner::cancel(void)
+{
+    if(!this->isRunning())
+        return;
+
+    cancelled = true;
+
+    process->terminate();
+
+    killTimer->start();
+}
+
+
+void ProcessRunner::handleStandardOutput(void)
+{
+    auto lines = this->takeLines(process->readAllStandardOutput(), outputBuffer);
+
+    for(auto&& line : lines)
+        this->handleLine(line, false);
+}
+
+
+void ProcessRunner::handleStandardError(void)
+{
+    auto lines = this->takeLines(process->readAllStandardError(), errorBuffer);
+
+    for(auto&& line : lines)
+        this->handleLine(line, true);
+}
+
+
+void ProcessRunner::handleFinished(int exitCode, QProcess::ExitStatus exitStatus)
+{
+    killTimer->stop();
+
+    // Emit any output after the last newline
+    this->handleStandardOutput();
+    this->handleStandardError();
+    this->flushBuffers();
+
+    emit finished(exitCode, exitStatus);
+}
+
+
+void ProcessRunner::handleError(QProcess::ProcessError error)
+{
+    // The other errors are followed by finished(), a process that failed to start never finishes
+    if(error != QProcess::FailedToStart)
+        return;
+
+    emit failedToStart(process->errorString());
+}
+
+
+QStringList ProcessRunner::takeLines(const QByteArray& text, QByteArray& buffer)
+{
+    buffer.append(text);
+
+    QStringList lines;
+
+    auto lineEnd = buffer.lastIndexOf('\n');
+
+    if(lineEnd == -1)
+        return lines;
+
+    auto completeLines = QString::fromLocal8Bit(buffer.constData(), lineEnd);
+    buffer.remove(0, lineEnd + 1);
+
+    for(auto&& line : completeLines.split('\n'))
+    {
+        // Remove the carriage return of windows line endings
+        if(line.endsWith('\r'))
+            line.chop(1);
+
+        lines.append(line);
+    }
+
+    return lines;
+}
+
+
+void ProcessRunner::flushBuffers(void)
+{
+    if(!outputBuffer.isEmpty())
+        this->handleLine(QString::fromLocal8Bit(outputBuffer).trimmed(), false);
+
+    if(!errorBuffer.isEmpty())
+        this->handleLine(QString::fromLocal8Bit(errorBuffer).trimmed(), true);
+
+    outputBuffer.clear();
+    errorBuffer.clear();
+}
+
+
+void ProcessRunner::handleLine(const QString& line, const bool isError)
+{
+    if(line.isEmpty())
+        return;
+
+    auto match = progressPattern.match(line);
+
+    if(match.hasMatch())
+    {
+        bool ok = false;
+        auto percent = match.captured(1).toDouble(&ok);
+
+        // A progress line is only reported as progress, not as output
+        if(ok)
+        {
+            emit progress(percent, match.captured(2).trimmed());
+            return;
+        }
+    }
+
+    if(isError)
+        emit errorLine(line);
+    else
+        emit outputLine(line);
+}
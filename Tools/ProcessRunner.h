@@ -0,0 +1,119 @@
+#ifndef PROCESSRUNNER_H
+#define PROCESSRUNNER_H
+/* *****************************************************************************
+Copyright (c) 2016-2021, The Regents of the University of California (Regents).
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those
+of the authors and should not be interpreted as representing official policies,
+either expressed or implied, of the FreeBSD Project.
+
+REGENTS SPECIFICALLY DISCLAIMS ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+THE SOFTWARE AND ACCOMPANYING DOCUMENTATION, IF ANY, PROVIDED HEREUNDER IS
+PROVIDED "AS IS". REGENTS HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+
+*************************************************************************** */
+
+
+#include <QObject>
+#include <QProcess>
+#include <QRegularExpression>
+#include <QStringList>
+
+class QTimer;
+
+// Runs a backend application without blocking the event loop
+//
+// The standard output and error of the process are streamed as whole lines. Lines that match the progress pattern are reported as progress instead of as output, by default these are lines such as "PROGRESS: 42% Simulating site 10 of 24".
+// The run can be cancelled, in which case the process is asked to terminate and is killed if it does not exit within the grace period.
+class ProcessRunner : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ProcessRunner(QObject *parent = nullptr);
+    ~ProcessRunner();
+
+    // Starts the program, returns false if a process is already running
+    bool start(const QString& program, const QStringList& arguments, const QString& workingDirectory = QString());
+
+    bool isRunning(void) const;
+
+    bool wasCancelled(void) const;
+
+    // The pattern must capture the percentage in the first group, and may capture a message in the second
+    void setProgressPattern(const QRegularExpression& pattern);
+
+    // Time that a cancelled process is given to exit before it is killed
+    void setTerminateTimeout(const int msec);
+
+public slots:
+
+    void cancel(void);
+
+signals:
+
+    void started(void);
+
+    void outputLine(const QString& line);
+    void errorLine(const QString& line);
+
+    void progress(const double percent, const QString& message);
+
+    // Emitted once the process has exited, including when it was cancelled
+    void finished(int exitCode, QProcess::ExitStatus exitStatus);
+
+    // Emitted instead of finished() if the program could not be started
+    void failedToStart(const QString& error);
+
+private slots:
+
+    void handleStandardOutput(void);
+    void handleStandardError(void);
+    void handleFinished(int exitCode, QProcess::ExitStatus exitStatus);
+    void handleError(QProcess::ProcessError error);
+
+private:
+
+    // Splits the text into lines, a partial line at the end is kept in the buffer until the rest of it arrives
+    QStringList takeLines(const QByteArray& text, QByteArray& buffer);
+
+    void flushBuffers(void);
+
+    void handleLine(const QString& line, const bool isError);
+
+    QProcess* process;
+
+    QTimer* killTimer;
+
+    QByteArray outputBuffer;
+    QByteArray errorBuffer;
+
+    QRegularExpression progressPattern;
+
+    bool cancelled = false;
+};
+
+#endif // PROCESSRUNNER_H
@@ -37,7 +37,6 @@ UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 // Written by: Stevan Gavrilovic
 
 #include "QGISHurricanePreprocessor.h"
-#include "CSVReaderWriter.h"
 #include "QGISVisualizationWidget.h"
 
 #include <qgsfield.h>
@@ -51,6 +50,8 @@ UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 #include <QProgressBar>
 #include <QList>
 
+#include <cmath>
+
 QGISHurricanePreprocessor::QGISHurricanePreprocessor(QProgressBar* pBar, QGISVisualizationWidget* visWidget, QObject* parent) : theProgressBar(pBar), theVisualizationWidget(visWidget), theParent(parent)
 {
     allHurricanesLayer = nullptr;
@@ -63,112 +64,19 @@ QGISHurricanePreprocessor::QGISHurricanePreprocessor(QProgressBar* pBar, QGISVis
 
 QgsVectorLayer* QGISHurricanePreprocessor::loadHurricaneDatabaseData(const QString &eventFile, QString &err)
 {
-    CSVReaderWriter csvTool;
-
-    QVector<QStringList> data = csvTool.parseCSVFile(eventFile, err);
-
-    if(!err.isEmpty())
-    {
-        return nullptr;
-    }
+    this->clear();
 
-    if(data.empty())
-    {
-        err = "Hurricane data is empty";
+    // The csv is only parsed the first time it is loaded, or when it has changed, afterwards the binary cache of it is mapped into memory
+    if(!database.open(eventFile, err))
         return nullptr;
-    }
-
-    // Get the header information to populate the fields
-    auto headerData = data.at(0);
-
-    auto numCol = headerData.size();
 
-    // Pop off the first two rows that contain the header and units information
-    data.pop_front();
-    data.pop_front();
-
-
-    // Split the hurricanes up as they come in one long list
-    QVectorIterator<QStringList> i(data);
-    QString SID;
-
-    HurricaneObject hurricane;
-    hurricane.parameterLabels = headerData;
-
-    auto indexLandfall = headerData.indexOf("DIST2LAND");
-    auto indexSID = headerData.indexOf("SID");
-
-    if(indexLandfall == -1 || indexSID == -1)
-    {
-        err = "Could not find the required column indexes in the data file";
-        return nullptr;
-    }
-
-    // While iterating through the hurricane points, save the data at first landfall
-    bool landfallFound = false;
-    while (i.hasNext())
-    {
-        auto row = i.next();
-
-        if(row.size() != numCol)
-        {
-            err = "Error, inconsistency in the data in the row and number of columns";
-            return nullptr;
-        }
-
-        // Not all hurricanes will make landfall
-        if(!landfallFound)
-        {
-            auto distToLand = row.at(indexLandfall);
-
-            // If the distance to land is 0, then this is the first landfall
-            if(distToLand.compare("0") == 0)
-            {
-                landfallFound = true;
-                hurricane.landfallData = row;
-                hurricane.indexLandfall = hurricane.size();
-            }
-        }
-
-        auto currSID = row.at(indexSID);
-
-        if(SID.compare(currSID) != 0)
-        {
-            if(!hurricane.empty())
-            {
-                hurricanes.push_back(hurricane);
-                hurricane.clear();
-                landfallFound = false;
-            }
-
-            SID = currSID;
-        }
-
-        hurricane.push_back(row);
-    }
-
-    // Push back the last hurricane
-    if(!hurricane.empty())
-        hurricanes.push_back(hurricane);
-
-    auto numHurricanes = hurricanes.size();
+    auto numHurricanes = database.numStorms();
 
     theProgressBar->setMinimum(0);
     theProgressBar->setMaximum(numHurricanes);
     theProgressBar->reset();
     QApplication::processEvents();
 
-    // Name and storm ID
-    auto indexName = headerData.indexOf("NAME");
-    auto indexSeason = headerData.indexOf("SEASON");
-
-    // Check that the indexes are found
-    if(indexName == -1 || indexSID == -1 || indexSeason == -1)
-    {
-        err = "Error adding a vector layer";
-        return nullptr;
-    }
-
     // Create the hurricane track fields
     QList<QgsField> attrib;
     attrib.append(QgsField("NAME", QVariant::String));
@@ -187,19 +95,16 @@ QgsVectorLayer* QGISHurricanePreprocessor::loadHurricaneDatabaseData(const QStri
 
     for(int i = 0; i<numHurricanes; ++i)
     {
-        theProgressBar->setValue(i);
-        QApplication::processEvents();
-
-        // Get the hurricane
-        HurricaneObject& hurricane = hurricanes[i];
-
-        auto name = hurricane.front().at(indexName);
-        auto SID = hurricane.front().at(indexSID);
-        auto season = hurricane.front().at(indexSeason);
+        if(i % 500 == 0)
+        {
+            theProgressBar->setValue(i);
+            QApplication::processEvents();
+        }
 
-        hurricane.name = name;
-        hurricane.SID = SID;
-        hurricane.season = season;
+        // Name and storm ID
+        auto name = database.getName(i);
+        auto SID = database.getSID(i);
+        auto season = database.getSeason(i);
         auto nameID = name+"-"+season;
 
         // Create a unique ID for this track
@@ -215,7 +120,7 @@ QgsVectorLayer* QGISHurricanePreprocessor::loadHurricaneDatabaseData(const QStri
 
         QgsFeature feature;
 
-        auto polyline = this->getTrackGeometry(&hurricane, err);
+        auto polyline = this->getTrackGeometry(i, err);
 
         if(polyline.isEmpty() || polyline.isNull())
             return nullptr;
@@ -227,6 +132,8 @@ QgsVectorLayer* QGISHurricanePreprocessor::loadHurricaneDatabaseData(const QStri
         featList.push_back(feature);
     }
 
+    theProgressBar->setValue(numHurricanes);
+
     // Create the buildings group layer that will hold the sublayers
     allHurricanesLayer = theVisualizationWidget->addVectorLayer("linestring","All Hurricanes");
 
@@ -266,7 +173,8 @@ QgsVectorLayer* QGISHurricanePreprocessor::loadHurricaneDatabaseData(const QStri
 
 void QGISHurricanePreprocessor::clear(void)
 {
-    hurricanes.clear();
+    loadedHurricanes.clear();
+    database.close();
     allHurricanesLayer = nullptr;
 }
 
@@ -518,13 +426,20 @@ QgsVectorLayer* QGISHurricanePreprocessor::createLandfallVisualization(const dou
 
 HurricaneObject* QGISHurricanePreprocessor::getHurricane(const QString& SID)
 {
-    for(auto&& it : hurricanes)
-    {
-        if(SID.compare(it.SID) == 0)
-            return &it;
-    }
+    // The track data of a hurricane is only decoded from the database the first time that it is requested
+    auto it = loadedHurricanes.find(SID);
+
+    if(it != loadedHurricanes.end())
+        return &it.value();
+
+    auto stormIndex = database.indexOfStorm(SID);
+
+    if(stormIndex == -1)
+        return nullptr;
 
-    return nullptr;
+    it = loadedHurricanes.insert(SID, database.getHurricane(stormIndex));
+
+    return &it.value();
 }
 
 
@@ -595,3 +510,32 @@ QgsGeometry QGISHurricanePreprocessor::getTrackGeometry(HurricaneObject* hurrica
 
     return geom;
 }
+
+
+QgsGeometry QGISHurricanePreprocessor::getTrackGeometry(const int stormIndex, QString& err)
+{
+    auto numPoints = database.numTrackPoints(stormIndex);
+    auto latitudes = database.trackLatitudes(stormIndex);
+    auto longitudes = database.trackLongitudes(stormIndex);
+
+    // Each row is a point on the hurricane track
+    QgsPolylineXY polyLine;
+    polyLine.reserve(numPoints);
+
+    for(int j = 0; j<numPoints; ++j)
+    {
+        auto latitude = latitudes[j];
+        auto longitude = longitudes[j];
+
+        // A coordinate that could not be parsed is stored as NaN
+        if(std::isnan(latitude) || std::isnan(longitude) || latitude == 0.0 || longitude == 0.0)
+        {
+            err = "Could not find the lat/lon from hurricane track points";
+            return QgsGeometry();
+        }
+
+        polyLine.push_back(QgsPointXY(longitude,latitude));
+    }
+
+    return QgsGeometry::fromPolylineXY(polyLine);
+}
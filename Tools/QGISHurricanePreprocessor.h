@@ -39,6 +39,7 @@ UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 // Written by: Stevan Gavrilovic
 
 #include "HurricaneObject.h"
+#include "HurricaneDatabaseCache.h"
 
 class QGISVisualizationWidget;
 
@@ -50,6 +51,7 @@ class QgsVectorLayer;
 #include <QStringList>
 #include <QVector>
 #include <QVariant>
+#include <QMap>
 
 class QObject;
 class QProgressBar;
@@ -81,11 +83,19 @@ public:
 private:
 
     QgsGeometry getTrackGeometry(HurricaneObject* hurricane, QString& err);
+
+    // Track geometry straight from the coordinates in the database, without decoding the hurricane
+    QgsGeometry getTrackGeometry(const int stormIndex, QString& err);
+
     QgsVectorLayer* allHurricanesLayer;
     QProgressBar* theProgressBar;
     QGISVisualizationWidget* theVisualizationWidget;
     QObject* theParent;
-    QVector<HurricaneObject> hurricanes;
+
+    HurricaneDatabaseCache database;
+
+    // The hurricanes that have been decoded from the database, by storm id
+    QMap<QString, HurricaneObject> loadedHurricanes;
 };
 
 #endif // QGISHurricanePreprocessor_H
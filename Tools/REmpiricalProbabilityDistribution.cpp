@@ -59,6 +59,9 @@ UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 
 #include "QDebug"
 
+#include <algorithm>
+#include <limits>
+
 REmpiricalProbabilityDistribution::REmpiricalProbabilityDistribution(QString objectName) : name(objectName)
 {
     numBins = 60;
@@ -69,20 +72,36 @@ REmpiricalProbabilityDistribution::REmpiricalProbabilityDistribution(QString obj
     histPlotHeight = 0.0;
     histogramArea = 0.0;
     binSize = 0.0;
+    runningMean = 0.0;
+    sumSquaredDeviations = 0.0;
     parameterSum = 0.0;
-    parameterSquaredSum = 0.0;
-    max = 0.0;
-    min = 0.0;
+    sumCompensation = 0.0;
+    max = -std::numeric_limits<double>::infinity();
+    min = std::numeric_limits<double>::infinity();
+    useSketch = false;
 }
 
 
 void REmpiricalProbabilityDistribution::addSample(const double& val)
 {
-    values.push_back(val);
-    parameterSum += val;
-    parameterSquaredSum += val*val;
+    if(useSketch)
+        quantileSketch.add(val);
+    else
+        values.push_back(val);
+
     ++n;
 
+    // Welford's update, the deviations are taken from the running mean so that large values do not cancel out
+    auto delta = val - runningMean;
+    runningMean += delta/static_cast<double>(n);
+    sumSquaredDeviations += delta*(val - runningMean);
+
+    // Kahan summation, the low order bits that are lost in the addition are carried over to the next sample
+    auto y = val - sumCompensation;
+    auto t = parameterSum + y;
+    sumCompensation = (t - parameterSum) - y;
+    parameterSum = t;
+
     if(val > max)
         max = val;
 
@@ -91,11 +110,32 @@ void REmpiricalProbabilityDistribution::addSample(const double& val)
 }
 
 
+void REmpiricalProbabilityDistribution::useQuantileSketch(const double compression)
+{
+    quantileSketch = TDigest(compression);
+
+    for(auto&& val : values)
+        quantileSketch.add(val);
+
+    values.clear();
+    values.squeeze();
+
+    useSketch = true;
+}
+
+
+bool REmpiricalProbabilityDistribution::isUsingQuantileSketch(void) const
+{
+    return useSketch;
+}
+
+
 double REmpiricalProbabilityDistribution::mean(void)
 {
-    auto num = static_cast<double>(n);
+    if(n == 0)
+        return 0.0;
 
-    return  parameterSum/num;
+    return runningMean;
 }
 
 
@@ -105,11 +145,42 @@ double REmpiricalProbabilityDistribution::stdDev(void)
     if(n<=1)
         return 0.0;
 
-    double meanVal = this->mean();
-
     auto num = static_cast<double>(n);
 
-    return sqrt(1.0/(num-1.0) * (parameterSquaredSum - num * meanVal * meanVal));
+    return sqrt(sumSquaredDeviations/(num-1.0));
+}
+
+
+double REmpiricalProbabilityDistribution::sum(void) const
+{
+    return parameterSum;
+}
+
+
+double REmpiricalProbabilityDistribution::quantile(const double p)
+{
+    if(n == 0)
+        return std::numeric_limits<double>::quiet_NaN();
+
+    if(useSketch)
+        return quantileSketch.quantile(p);
+
+    // Interpolate between the two order statistics that bracket the quantile, only those are needed so a full sort is avoided
+    QVector<double> sorted = values;
+
+    auto position = std::min(std::max(p, 0.0), 1.0)*(sorted.size()-1);
+    auto lowerIndex = static_cast<int>(floor(position));
+    auto fraction = position - lowerIndex;
+
+    std::nth_element(sorted.begin(), sorted.begin()+lowerIndex, sorted.end());
+    auto lower = sorted.at(lowerIndex);
+
+    if(fraction == 0.0 || lowerIndex + 1 >= sorted.size())
+        return lower;
+
+    auto upper = *std::min_element(sorted.begin()+lowerIndex+1, sorted.end());
+
+    return lower + fraction*(upper - lower);
 }
 
 
@@ -223,20 +294,33 @@ int REmpiricalProbabilityDistribution::getNumberSamples() const
 }
 
 
-QVector<double> REmpiricalProbabilityDistribution::getValues() const
+QVector<double> REmpiricalProbabilityDistribution::getValues()
 {
-    return values;
+    if(!useSketch)
+        return values;
+
+    QVector<double> centroidMeans;
+    for(auto&& centroid : quantileSketch.getCentroids())
+        centroidMeans.push_back(centroid.mean);
+
+    return centroidMeans;
 }
 
 
 double REmpiricalProbabilityDistribution::getMax() const
 {
+    if(n == 0)
+        return 0.0;
+
     return max;
 }
 
 
 double REmpiricalProbabilityDistribution::getMin() const
 {
+    if(n == 0)
+        return 0.0;
+
     return min;
 }
 
@@ -263,6 +347,25 @@ QVector<double>  REmpiricalProbabilityDistribution::updateHistogram()
     histogramMax = meanVal + 5.0 * stdv;
     binSize = (histogramMax - histogramMin) / numBins;
 
+    // Create histogram from the sketch, the count of each bin is the number of samples times the probability mass in the bin
+    if(useSketch)
+    {
+        auto num = static_cast<double>(n);
+        auto lowerProbability = 0.0;
+        for (int k=1; k<numBins; ++k) {
+
+            auto upperProbability = quantileSketch.cdf(histogramMin + static_cast<double>(k) * binSize);
+
+            theHistogram[k] = num * (upperProbability - lowerProbability);
+
+            if (theHistogram[k] > histogramHeight) {
+                histogramHeight = theHistogram[k];
+            }
+
+            lowerProbability = upperProbability;
+        }
+    }
+
     // Create histogram
     for (int j=0; j<values.size(); ++j) {
 
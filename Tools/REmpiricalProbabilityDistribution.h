@@ -57,6 +57,8 @@ UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 
 *************************************************************************** */
 
+#include "TDigest.h"
+
 #include <math.h>
 #include <vector>
 #include <QVector>
@@ -68,12 +70,24 @@ public:
 
     void addSample(const double& val);
 
+    // Replaces the stored samples with a t-digest of the given compression, so that the memory is bounded regardless of the number of samples
+    // Samples that were already added are moved into the sketch. The histogram and the quantiles are then estimated from the sketch
+    void useQuantileSketch(const double compression = 100.0);
+
+    bool isUsingQuantileSketch(void) const;
+
     double mean(void);
 
     double stdDev(void);
 
     double CV(void);
 
+    // Sum of the samples with compensated (Kahan) summation
+    double sum(void) const;
+
+    // Value at the probability 0 <= p <= 1, exact if the samples are stored and estimated if the quantile sketch is used
+    double quantile(const double p);
+
     QVector<double>  updateHistogram();
 
     // For plotting
@@ -94,8 +108,10 @@ public:
 
     int getNumberSamples() const;
 
-    QVector<double> getValues() const;
+    // Returns the samples, or the centroid means of the sketch if the quantile sketch is used
+    QVector<double> getValues();
 
+    // The largest and smallest samples, zero if there are no samples
     double getMax() const;
 
     double getMin() const;
@@ -117,9 +133,19 @@ private:
 
     double max;
     double min;
+
+    // Running mean and sum of squared deviations from the mean (Welford)
+    double runningMean;
+    double sumSquaredDeviations;
+
+    // Kahan summation of the samples and its running compensation
     double parameterSum;
-    double parameterSquaredSum;
+    double sumCompensation;
+
     int n;
+
+    bool useSketch;
+    TDigest quantileSketch;
 };
 
 #endif // REMPIRICALPROBABILITYDISTRIBUTION_H
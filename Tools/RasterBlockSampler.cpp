@@ -0,0 +1,215 @@
+/* *****************************************************************************
+Copyright (c) 2016-2021, The Regents of the University of California (Regents).
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those
+of the authors and should not be interpreted as representing official policies,
+either expressed or implied, of the FreeBSD Project.
+
+REGENTS SPECIFICALLY DISCLAIMS ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+THE SOFTWARE AND ACCOMPANYING DOCUMENTATION, IF ANY, PROVIDED HEREUNDER IS
+PROVIDED "AS IS". REGENTS HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+
+*************************************************************************** */
+
+
+#include "RasterBlockSampler.h"
+
+#include <qgsrasterdataprovider.h>
+#include <qgsrasterblock.h>
+#include <qgsrectangle.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <vector>
+
+RasterBlockSampler::RasterBlockSampler(QgsRasterDataProvider* provider, const int tileSize) : dataProvider(provider), tileSize(std::max(tileSize, 1))
+{
+    outOfBoundsValue = std::numeric_limits<double>::quiet_NaN();
+    noDataValue = std::numeric_limits<double>::quiet_NaN();
+}
+
+
+int RasterBlockSampler::sample(const QVector<QgsPointXY>& points, const QList<int>& bands, QVector<double>& values, QString& err)
+{
+    numOutOfBounds = 0;
+    numNoData = 0;
+
+    if(dataProvider == nullptr || !dataProvider->isValid())
+    {
+        err = "Error, attempting to sample a raster layer that has not been loaded";
+        return -1;
+    }
+
+    auto numBands = dataProvider->bandCount();
+
+    for(auto&& band : bands)
+    {
+        if(band < 1 || band > numBands)
+        {
+            err = "Error, the band number given "+QString::number(band)+" is not in the range of bands in the raster: 1 to "+QString::number(numBands);
+            return -1;
+        }
+    }
+
+    const auto nPts = points.size();
+    const auto nBands = bands.size();
+
+    values.fill(outOfBoundsValue, nPts*nBands);
+
+    const auto extent = dataProvider->extent();
+    const auto nCols = dataProvider->xSize();
+    const auto nRows = dataProvider->ySize();
+
+    if(nCols <= 0 || nRows <= 0 || extent.isEmpty())
+    {
+        err = "Error, the raster has no cells to sample";
+        return -1;
+    }
+
+    const auto cellWidth = extent.width()/nCols;
+    const auto cellHeight = extent.height()/nRows;
+
+    const qint64 numTileCols = (nCols + tileSize - 1)/tileSize;
+
+    // The cell of each point and the tile it falls in, the points outside of the raster are left out
+    struct CellRef
+    {
+        qint64 tile;
+        int row;
+        int col;
+        int point;
+    };
+
+    std::vector<CellRef> cells;
+    cells.reserve(nPts);
+
+    for(int i = 0; i<nPts; ++i)
+    {
+        const auto& pt = points.at(i);
+
+        auto col = std::floor((pt.x() - extent.xMinimum())/cellWidth);
+        auto row = std::floor((extent.yMaximum() - pt.y())/cellHeight);
+
+        if(!(col >= 0 && col < nCols && row >= 0 && row < nRows))
+        {
+            ++numOutOfBounds;
+            continue;
+        }
+
+        CellRef cell;
+        cell.row = static_cast<int>(row);
+        cell.col = static_cast<int>(col);
+        cell.tile = (cell.row/tileSize)*numTileCols + cell.col/tileSize;
+        cell.point = i;
+
+        cells.push_back(cell);
+    }
+
+    std::sort(cells.begin(), cells.end(), [](const CellRef& a, const CellRef& b)
+    {
+        return a.tile < b.tile || (a.tile == b.tile && a.point < b.point);
+    });
+
+    // A point is counted once even if it is on a no-data cell in more than one band
+    std::vector<bool> isNoDataPoint(nPts, false);
+
+    // Read each tile once per band and sample all of the points that fall within it
+    for(size_t start = 0; start < cells.size();)
+    {
+        auto end = start;
+        while(end < cells.size() && cells[end].tile == cells[start].tile)
+            ++end;
+
+        const auto row0 = static_cast<int>(cells[start].tile/numTileCols)*tileSize;
+        const auto col0 = static_cast<int>(cells[start].tile%numTileCols)*tileSize;
+        const auto width = std::min(tileSize, nCols - col0);
+        const auto height = std::min(tileSize, nRows - row0);
+
+        // The tile extent is aligned to the cell grid so that the block is read without resampling
+        auto xMin = extent.xMinimum() + col0*cellWidth;
+        auto yMax = extent.yMaximum() - row0*cellHeight;
+        QgsRectangle tileExtent(xMin, yMax - height*cellHeight, xMin + width*cellWidth, yMax);
+
+        for(int b = 0; b<nBands; ++b)
+        {
+            std::unique_ptr<QgsRasterBlock> block(dataProvider->block(bands.at(b), tileExtent, width, height));
+
+            if(block == nullptr || !block->isValid())
+            {
+                err = "Error reading a block of band "+QString::number(bands.at(b))+" from the raster";
+                return -1;
+            }
+
+            for(auto i = start; i<end; ++i)
+            {
+                const auto& cell = cells[i];
+
+                auto r = cell.row - row0;
+                auto c = cell.col - col0;
+
+                if(block->isNoData(r, c))
+                {
+                    values[cell.point*nBands + b] = noDataValue;
+                    isNoDataPoint[cell.point] = true;
+                }
+                else
+                    values[cell.point*nBands + b] = block->value(r, c);
+            }
+        }
+
+        start = end;
+    }
+
+    numNoData = static_cast<int>(std::count(isNoDataPoint.begin(), isNoDataPoint.end(), true));
+
+    return 0;
+}
+
+
+void RasterBlockSampler::setOutOfBoundsValue(const double val)
+{
+    outOfBoundsValue = val;
+}
+
+
+void RasterBlockSampler::setNoDataValue(const double val)
+{
+    noDataValue = val;
+}
+
+
+int RasterBlockSampler::getNumOutOfBounds(void) const
+{
+    return numOutOfBounds;
+}
+
+
+int RasterBlockSampler::getNumNoData(void) const
+{
+    return numNoData;
+}
@@ -0,0 +1,83 @@
+#ifndef RasterBlockSampler_H
+#define RasterBlockSampler_H
+/* *****************************************************************************
+Copyright (c) 2016-2021, The Regents of the University of California (Regents).
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those
+of the authors and should not be interpreted as representing official policies,
+either expressed or implied, of the FreeBSD Project.
+
+REGENTS SPECIFICALLY DISCLAIMS ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+THE SOFTWARE AND ACCOMPANYING DOCUMENTATION, IF ANY, PROVIDED HEREUNDER IS
+PROVIDED "AS IS". REGENTS HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+
+*************************************************************************** */
+
+
+#include <qgspointxy.h>
+
+#include <QList>
+#include <QString>
+#include <QVector>
+
+class QgsRasterDataProvider;
+
+// Samples a raster at many points at once. The points are grouped by the raster tile they fall in and each tile is read
+// once per band, instead of going through QgsRasterDataProvider::sample for every point and band
+// The points must be in the CRS of the raster
+class RasterBlockSampler
+{
+public:
+    RasterBlockSampler(QgsRasterDataProvider* provider, const int tileSize = 512);
+
+    // Returns the values in a points x bands row-major array, where the band numbers start at 1
+    // No-data cells get the no-data value and points outside of the raster get the out of bounds value
+    int sample(const QVector<QgsPointXY>& points, const QList<int>& bands, QVector<double>& values, QString& err);
+
+    // The value given to points that fall outside of the raster, NaN by default
+    void setOutOfBoundsValue(const double val);
+
+    // The value given to no-data cells, NaN by default
+    void setNoDataValue(const double val);
+
+    // The number of points that fell outside of the raster in the last call to sample
+    int getNumOutOfBounds(void) const;
+
+    // The number of points that fell on a no-data cell in at least one band in the last call to sample
+    int getNumNoData(void) const;
+
+private:
+
+    QgsRasterDataProvider* dataProvider = nullptr;
+
+    int tileSize;
+    double outOfBoundsValue;
+    double noDataValue;
+    int numOutOfBounds = 0;
+    int numNoData = 0;
+};
+
+#endif // RasterBlockSampler_H
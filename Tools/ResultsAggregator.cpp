@@ -0,0 +1,268 @@
+/* *****************************************************************************
+Copyright (c) 2016-2021, The Regents of the University of California (Regents).
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those
+of the authors and should not be interpreted as representing official policies,
+either expressed or implied, of the FreeBSD Project.
+
+REGENTS SPECIFICALLY DISCLAIMS ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+THE SOFTWARE AND ACCOMPANYING DOCUMENTATION, IF ANY, PROVIDED HEREUNDER IS
+PROVIDED "AS IS". REGENTS HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+
+*************************************************************************** */
+
+
+#include "ResultsAggregator.h"
+#include "ColumnarTable.h"
+
+#include <algorithm>
+#include <cmath>
+
+double ResultsAggregator::Aggregate::mean(void) const
+{
+    if(count == 0)
+        return 0.0;
+
+    return total/static_cast<double>(count);
+}
+
+
+void ResultsAggregator::Aggregate::add(const double value)
+{
+    ++count;
+    total += value;
+    min = std::min(min, value);
+    max = std::max(max, value);
+}
+
+
+void ResultsAggregator::Aggregate::merge(const Aggregate& other)
+{
+    count += other.count;
+    total += other.total;
+    min = std::min(min, other.min);
+    max = std::max(max, other.max);
+}
+
+
+ResultsAggregator::ResultsAggregator()
+{
+
+}
+
+
+void ResultsAggregator::addGroup(const QString& group, const QStringList& columns)
+{
+    if(!groups.contains(group))
+        groupNames.append(group);
+
+    auto& newGroup = groups[group];
+    newGroup.columns = columns;
+    newGroup.aggregates = QVector<Aggregate>(columns.size());
+}
+
+
+void ResultsAggregator::addRow(const QString& group, const QVector<double>& values)
+{
+    auto it = groups.find(group);
+    if(it == groups.end())
+        return;
+
+    auto& aggregates = it->aggregates;
+
+    auto numValues = std::min(values.size(), aggregates.size());
+    for(int i = 0; i<numValues; ++i)
+    {
+        auto value = values.at(i);
+        if(!std::isnan(value))
+            aggregates[i].add(value);
+    }
+}
+
+
+int ResultsAggregator::addTable(const QString& group, const ColumnarTable& table, QString& err, const QVector<int>& rows)
+{
+    auto it = groups.find(group);
+    if(it == groups.end())
+    {
+        err = "The group "+group+" has not been added to the aggregates";
+        return -1;
+    }
+
+    const auto& columns = it->columns;
+
+    QVector<int> tableColumns;
+    tableColumns.reserve(columns.size());
+
+    for(auto&& column : columns)
+    {
+        auto col = table.columnIndex(column);
+        if(col == -1 || table.columnType(col) == ColumnarTable::StringColumn)
+        {
+            err = "The column "+column+" is not a numeric column of the table of the group "+group;
+            return -1;
+        }
+
+        tableColumns.append(col);
+    }
+
+    for(auto&& row : rows)
+    {
+        if(row < 0 || row >= table.rowCount())
+        {
+            err = "The row "+QString::number(row)+" is not in the table of the group "+group;
+            return -1;
+        }
+    }
+
+    auto& aggregates = it->aggregates;
+    aggregates = QVector<Aggregate>(columns.size());
+
+    auto addTableRow = [&](const int row)
+    {
+        for(int i = 0; i<tableColumns.size(); ++i)
+        {
+            auto col = tableColumns.at(i);
+            if(!table.isNull(row,col))
+                aggregates[i].add(table.doubleValue(row,col));
+        }
+    };
+
+    if(rows.isEmpty())
+    {
+        for(int row = 0; row<table.rowCount(); ++row)
+            addTableRow(row);
+    }
+    else
+    {
+        for(auto&& row : rows)
+            addTableRow(row);
+    }
+
+    return 0;
+}
+
+
+void ResultsAggregator::clear(void)
+{
+    groupNames.clear();
+    groups.clear();
+}
+
+
+QStringList ResultsAggregator::getGroups(void) const
+{
+    return groupNames;
+}
+
+
+QStringList ResultsAggregator::getColumns(const QString& group) const
+{
+    return groups.value(group).columns;
+}
+
+
+ResultsAggregator::Aggregate ResultsAggregator::getAggregate(const QString& column) const
+{
+    Aggregate aggregate;
+
+    for(auto&& group : groupNames)
+        aggregate.merge(this->getAggregate(group, column));
+
+    return aggregate;
+}
+
+
+ResultsAggregator::Aggregate ResultsAggregator::getAggregate(const QString& group, const QString& column) const
+{
+    auto it = groups.constFind(group);
+    if(it == groups.constEnd())
+        return Aggregate();
+
+    auto index = it->columns.indexOf(column);
+    if(index == -1)
+        return Aggregate();
+
+    return it->aggregates.at(index);
+}
+
+
+double ResultsAggregator::getQuantile(const ColumnarTable& table, const QString& column, const double p, QString& err, const QVector<int>& rows)
+{
+    if(p < 0.0 || p > 1.0)
+    {
+        err = "The quantile probability must be between 0 and 1";
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+
+    auto col = table.columnIndex(column);
+    if(col == -1 || table.columnType(col) == ColumnarTable::StringColumn)
+    {
+        err = "The column "+column+" is not a numeric column of the table";
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+
+    QVector<double> values;
+    values.reserve(rows.isEmpty() ? table.rowCount() : rows.size());
+
+    auto addValue = [&](const int row)
+    {
+        if(row >= 0 && row < table.rowCount() && !table.isNull(row,col))
+            values.append(table.doubleValue(row,col));
+    };
+
+    if(rows.isEmpty())
+    {
+        for(int row = 0; row<table.rowCount(); ++row)
+            addValue(row);
+    }
+    else
+    {
+        for(auto&& row : rows)
+            addValue(row);
+    }
+
+    if(values.isEmpty())
+    {
+        err = "The column "+column+" does not have any values";
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+
+    // Only the two order statistics that bracket the quantile are needed, so a full sort is avoided
+    auto position = p*(values.size()-1);
+    auto lowerIndex = static_cast<int>(std::floor(position));
+    auto fraction = position - lowerIndex;
+
+    std::nth_element(values.begin(), values.begin()+lowerIndex, values.end());
+    auto lower = values.at(lowerIndex);
+
+    if(fraction == 0.0 || lowerIndex + 1 >= values.size())
+        return lower;
+
+    auto upper = *std::min_element(values.begin()+lowerIndex+1, values.end());
+
+    return lower + fraction*(upper - lower);
+}
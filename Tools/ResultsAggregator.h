@@ -0,0 +1,108 @@
+#ifndef RESULTSAGGREGATOR_H
+#define RESULTSAGGREGATOR_H
+/* *****************************************************************************
+Copyright (c) 2016-2021, The Regents of the University of California (Regents).
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those
+of the authors and should not be interpreted as representing official policies,
+either expressed or implied, of the FreeBSD Project.
+
+REGENTS SPECIFICALLY DISCLAIMS ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+THE SOFTWARE AND ACCOMPANYING DOCUMENTATION, IF ANY, PROVIDED HEREUNDER IS
+PROVIDED "AS IS". REGENTS HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+
+*************************************************************************** */
+
+
+#include <QHash>
+#include <QStringList>
+#include <QVector>
+
+#include <limits>
+
+class ColumnarTable;
+
+// Totals, means, and extremes of result columns, broken down by group (e.g., asset type)
+// Rows are added one at a time while the results are loaded, so that the aggregates are available as soon as the loading is done
+// Aggregates of a subset of the assets can be recomputed from the loaded tables without parsing the results again
+// The columns are named as in the header of the results table, and only the columns given to addGroup are aggregated, so that the id columns are left out
+class ResultsAggregator
+{
+public:
+
+    struct Aggregate
+    {
+        qint64 count = 0;
+        double total = 0.0;
+        double min = std::numeric_limits<double>::infinity();
+        double max = -std::numeric_limits<double>::infinity();
+
+        double mean(void) const;
+
+        void add(const double value);
+        void merge(const Aggregate& other);
+    };
+
+    ResultsAggregator();
+
+    // Adds a group with the columns that are aggregated, an existing group with the same name is reset
+    void addGroup(const QString& group, const QStringList& columns);
+
+    // Adds the values of one row to a group, the values are in the order of the group columns. NaN values are skipped
+    void addRow(const QString& group, const QVector<double>& values);
+
+    // Recomputes the aggregates of an existing group from a table, the columns of the group are found by name in the table header
+    // If rows are given, only those rows of the table are added
+    int addTable(const QString& group, const ColumnarTable& table, QString& err, const QVector<int>& rows = QVector<int>());
+
+    void clear(void);
+
+    QStringList getGroups(void) const;
+    QStringList getColumns(const QString& group) const;
+
+    // Aggregate of a column over all of the groups that have the column
+    Aggregate getAggregate(const QString& column) const;
+
+    // Aggregate of a column in one group
+    Aggregate getAggregate(const QString& group, const QString& column) const;
+
+    // Quantile (0 <= p <= 1) of a numeric column of a table, interpolated between the order statistics. If rows are given, only those rows are used
+    // Computed from the typed column store of the table, null cells are skipped
+    static double getQuantile(const ColumnarTable& table, const QString& column, const double p, QString& err, const QVector<int>& rows = QVector<int>());
+
+private:
+
+    struct Group
+    {
+        QStringList columns;
+        QVector<Aggregate> aggregates;
+    };
+
+    QStringList groupNames;
+    QHash<QString, Group> groups;
+};
+
+#endif // RESULTSAGGREGATOR_H
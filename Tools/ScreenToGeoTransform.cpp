@@ -0,0 +1,111 @@
+/* *****************************************************************************
+Copyright (c) 2016-2021, The Regents of the University of California (Regents).
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those
+of the authors and should not be interpreted as representing official policies,
+either expressed or implied, of the FreeBSD Project.
+
+REGENTS SPECIFICALLY DISCLAIMS ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+THE SOFTWARE AND ACCOMPANYING DOCUMENTATION, IF ANY, PROVIDED HEREUNDER IS
+PROVIDED "AS IS". REGENTS HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+
+*************************************************************************** */
+
+
+#include "ScreenToGeoTransform.h"
+
+#include <qgsmapcanvas.h>
+#include <qgsexception.h>
+#include <qgsproject.h>
+
+ScreenToGeoTransform::ScreenToGeoTransform(const QgsMapCanvas* canvas)
+{
+    const auto& mapSettings = canvas->mapSettings();
+
+    mapToPixel = mapSettings.mapToPixel();
+
+    auto canvasCrs = mapSettings.destinationCrs();
+    auto geographicCrs = QgsCoordinateReferenceSystem("EPSG:4326");
+
+    needsReprojection = (canvasCrs != geographicCrs);
+
+    if(needsReprojection)
+        toGeographic = QgsCoordinateTransform(canvasCrs, geographicCrs, QgsProject::instance());
+}
+
+
+int ScreenToGeoTransform::transform(const QVector<QPointF>& screenPoints, QVector<double>& latitudes, QVector<double>& longitudes, QString& err) const
+{
+    const auto numPoints = screenPoints.size();
+
+    // Screen to map coordinates, in the CRS of the canvas
+    longitudes.resize(numPoints);
+    latitudes.resize(numPoints);
+
+    for(int i = 0; i<numPoints; ++i)
+    {
+        auto mapPoint = mapToPixel.toMapCoordinates(screenPoints.at(i).x(), screenPoints.at(i).y());
+        longitudes[i] = mapPoint.x();
+        latitudes[i] = mapPoint.y();
+    }
+
+    if(!needsReprojection || numPoints == 0)
+        return 0;
+
+    // Reproject all of the points in a single call
+    QVector<double> z(numPoints, 0.0);
+
+    try
+    {
+        toGeographic.transformCoords(numPoints, longitudes.data(), latitudes.data(), z.data());
+    }
+    catch (QgsCsException &e)
+    {
+        err = "Error transforming the screen points to latitude and longitude: " + e.what();
+        return -1;
+    }
+
+    return 0;
+}
+
+
+QVector<QgsPointXY> ScreenToGeoTransform::toGeographic(const QgsMapCanvas* canvas, const QVector<QPointF>& screenPoints, QString& err)
+{
+    QVector<double> latitudes;
+    QVector<double> longitudes;
+
+    ScreenToGeoTransform screenToGeo(canvas);
+    if(screenToGeo.transform(screenPoints, latitudes, longitudes, err) != 0)
+        return QVector<QgsPointXY>();
+
+    QVector<QgsPointXY> geoPoints;
+    geoPoints.reserve(screenPoints.size());
+
+    for(int i = 0; i<screenPoints.size(); ++i)
+        geoPoints.append(QgsPointXY(longitudes.at(i), latitudes.at(i)));
+
+    return geoPoints;
+}
@@ -0,0 +1,70 @@
+#ifndef ScreenToGeoTransform_H
+#define ScreenToGeoTransform_H
+/* *****************************************************************************
+Copyright (c) 2016-2021, The Regents of the University of California (Regents).
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those
+of the authors and should not be interpreted as representing official policies,
+either expressed or implied, of the FreeBSD Project.
+
+REGENTS SPECIFICALLY DISCLAIMS ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+THE SOFTWARE AND ACCOMPANYING DOCUMENTATION, IF ANY, PROVIDED HEREUNDER IS
+PROVIDED "AS IS". REGENTS HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+
+*************************************************************************** */
+
+
+#include <qgscoordinatetransform.h>
+#include <qgsmaptopixel.h>
+#include <qgspointxy.h>
+
+#include <QPointF>
+#include <QString>
+#include <QVector>
+
+class QgsMapCanvas;
+
+// Converts screen points on a map canvas to latitude and longitude in EPSG:4326
+// The map to pixel and CRS transforms are set up once, for the canvas extent at the time of construction, and then applied to whole arrays of points
+class ScreenToGeoTransform
+{
+public:
+    ScreenToGeoTransform(const QgsMapCanvas* canvas);
+
+    int transform(const QVector<QPointF>& screenPoints, QVector<double>& latitudes, QVector<double>& longitudes, QString& err) const;
+
+    // Convenience for a single conversion with the current extent of the canvas, the points are returned with x as the longitude and y as the latitude
+    // The error is set if the points could not be reprojected
+    static QVector<QgsPointXY> toGeographic(const QgsMapCanvas* canvas, const QVector<QPointF>& screenPoints, QString& err);
+
+private:
+
+    QgsMapToPixel mapToPixel;
+    QgsCoordinateTransform toGeographic;
+    bool needsReprojection = false;
+};
+
+#endif // ScreenToGeoTransform_H
@@ -0,0 +1,96 @@
+/* *****************************************************************************
+Copyright (c) 2016-2021, The Regents of the University of California (Regents).
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those
+of the authors and should not be interpreted as representing official policies,
+either expressed or implied, of the FreeBSD Project.
+
+REGENTS SPECIFICALLY DISCLAIMS ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+THE SOFTWARE AND ACCOMPANYING DOCUMENTATION, IF ANY, PROVIDED HEREUNDER IS
+PROVIDED "AS IS". REGENTS HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+
+*************************************************************************** */
+
+#include "SpatialBoxIndex.h"
+
+#include <algorithm>
+
+SpatialBoxIndex::SpatialBoxIndex()
+{
+
+}
+
+
+void SpatialBoxIndex::insert(const QgsFeatureId id, const QgsRectangle& box)
+{
+    if(box.isNull())
+        return;
+
+    index.addFeature(id, box);
+    boxes.insert(id, box);
+}
+
+
+void SpatialBoxIndex::clear(void)
+{
+    index = QgsSpatialIndex();
+    boxes.clear();
+}
+
+
+int SpatialBoxIndex::size(void) const
+{
+    return boxes.size();
+}
+
+
+QList<QgsFeatureId> SpatialBoxIndex::candidatesContaining(const QgsPointXY& point) const
+{
+    // A degenerate rectangle at the point
+    QgsRectangle searchBox(point.x(), point.y(), point.x(), point.y(), false);
+
+    auto ids = index.intersects(searchBox);
+
+    // Filter out the boxes that only touch the search box because of the tree's tolerance
+    ids.erase(std::remove_if(ids.begin(), ids.end(), [this, &point](const QgsFeatureId id){
+        return !boxes.value(id).contains(point);
+    }), ids.end());
+
+    std::sort(ids.begin(), ids.end());
+
+    return ids;
+}
+
+
+QgsFeatureId SpatialBoxIndex::firstContaining(const QgsPointXY& point) const
+{
+    auto ids = this->candidatesContaining(point);
+
+    if(ids.isEmpty())
+        return FID_NULL;
+
+    return ids.first();
+}
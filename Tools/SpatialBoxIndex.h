@@ -0,0 +1,74 @@
+#ifndef SPATIALBOXINDEX_H
+#define SPATIALBOXINDEX_H
+/* *****************************************************************************
+Copyright (c) 2016-2021, The Regents of the University of California (Regents).
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those
+of the authors and should not be interpreted as representing official policies,
+either expressed or implied, of the FreeBSD Project.
+
+REGENTS SPECIFICALLY DISCLAIMS ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+THE SOFTWARE AND ACCOMPANYING DOCUMENTATION, IF ANY, PROVIDED HEREUNDER IS
+PROVIDED "AS IS". REGENTS HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+
+*************************************************************************** */
+
+#include <qgsspatialindex.h>
+#include <qgsfeatureid.h>
+#include <qgsrectangle.h>
+#include <qgspointxy.h>
+
+#include <QHash>
+#include <QList>
+
+// R-tree over the bounding boxes of features, used for point-in-feature searches such as matching buildings to parcels
+// The tree only gives the candidates whose boxes contain the point, an exact geometry test is left up to the caller
+class SpatialBoxIndex
+{
+public:
+    SpatialBoxIndex();
+
+    void insert(const QgsFeatureId id, const QgsRectangle& box);
+
+    void clear(void);
+
+    int size(void) const;
+
+    // Returns the ids of the features whose bounding boxes contain the point, in ascending order of id
+    QList<QgsFeatureId> candidatesContaining(const QgsPointXY& point) const;
+
+    // Returns the lowest id of the features whose bounding boxes contain the point, or FID_NULL if there is none
+    QgsFeatureId firstContaining(const QgsPointXY& point) const;
+
+private:
+
+    QgsSpatialIndex index;
+
+    // The boxes are kept so that the candidates from the tree can be checked against the point exactly
+    QHash<QgsFeatureId, QgsRectangle> boxes;
+};
+
+#endif // SPATIALBOXINDEX_H
@@ -0,0 +1,247 @@
+/* *****************************************************************************
+Copyright (c) 2016-2021, The Regents of the University of California (Regents).
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those
+of the authors and should not be interpreted as representing official policies,
+either expressed or implied, of the FreeBSD Project.
+
+REGENTS SPECIFICALLY DISCLAIMS ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+THE SOFTWARE AND ACCOMPANYING DOCUMENTATION, IF ANY, PROVIDED HEREUNDER IS
+PROVIDED "AS IS". REGENTS HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+
+*************************************************************************** */
+
+
+#include "TDigest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+const double pi = 3.14159265358979323846;
+
+// The k1 scale function, it limits the size of a centroid to about q*(1-q)/compression of the samples
+double kScale(const double q, const double compression)
+{
+    return compression/(2.0*pi)*std::asin(2.0*q - 1.0);
+}
+
+
+double kScaleInverse(const double k, const double compression)
+{
+    // The scale function saturates at compression/4, past that point a centroid can grow up to the end of the distribution
+    if(k >= 0.25*compression)
+        return 1.0;
+
+    return 0.5*(std::sin(k*2.0*pi/compression) + 1.0);
+}
+}
+
+
+TDigest::TDigest(const double compression) : compression(std::max(compression, 10.0))
+{
+    this->clear();
+}
+
+
+void TDigest::add(const double value, const double weight)
+{
+    if(std::isnan(value) || weight <= 0.0)
+        return;
+
+    buffer.push_back({value, weight});
+
+    totalWeight += weight;
+    min = std::min(min, value);
+    max = std::max(max, value);
+
+    // The buffer is merged in batches so that the sort is amortized over many samples
+    if(buffer.size() >= static_cast<size_t>(5.0*compression))
+        this->flush();
+}
+
+
+void TDigest::clear(void)
+{
+    centroids.clear();
+    buffer.clear();
+
+    totalWeight = 0.0;
+    min = std::numeric_limits<double>::infinity();
+    max = -std::numeric_limits<double>::infinity();
+}
+
+
+void TDigest::flush(void)
+{
+    if(buffer.empty())
+        return;
+
+    buffer.insert(buffer.end(), centroids.begin(), centroids.end());
+
+    std::sort(buffer.begin(), buffer.end(), [](const Centroid& a, const Centroid& b)
+    {
+        return a.mean < b.mean;
+    });
+
+    centroids.clear();
+
+    // Neighbouring centroids are merged as long as the merged centroid spans less than one unit of the scale function
+    auto weightSoFar = 0.0;
+    auto qLimit = kScaleInverse(kScale(0.0, compression) + 1.0, compression);
+
+    auto current = buffer.front();
+    for(size_t i = 1; i<buffer.size(); ++i)
+    {
+        const auto& next = buffer[i];
+
+        auto q = (weightSoFar + current.weight + next.weight)/totalWeight;
+
+        if(q <= qLimit)
+        {
+            current.weight += next.weight;
+            current.mean += (next.mean - current.mean)*next.weight/current.weight;
+        }
+        else
+        {
+            centroids.push_back(current);
+            weightSoFar += current.weight;
+            qLimit = kScaleInverse(kScale(weightSoFar/totalWeight, compression) + 1.0, compression);
+            current = next;
+        }
+    }
+
+    centroids.push_back(current);
+
+    buffer.clear();
+}
+
+
+double TDigest::quantile(const double p)
+{
+    this->flush();
+
+    if(centroids.empty())
+        return std::numeric_limits<double>::quiet_NaN();
+
+    auto index = std::min(std::max(p, 0.0), 1.0)*totalWeight;
+
+    // Half of the weight of each centroid is taken to be on either side of its mean, the values are interpolated between the centroid means
+    // Below the first and above the last centroid, the values are interpolated towards the smallest and largest samples
+    const auto& first = centroids.front();
+    if(index <= 0.5*first.weight)
+        return min + (first.mean - min)*index/(0.5*first.weight);
+
+    auto cumulative = 0.5*first.weight;
+    for(size_t i = 0; i+1<centroids.size(); ++i)
+    {
+        auto dw = 0.5*(centroids[i].weight + centroids[i+1].weight);
+
+        if(index <= cumulative + dw)
+        {
+            auto t = (index - cumulative)/dw;
+            return centroids[i].mean + t*(centroids[i+1].mean - centroids[i].mean);
+        }
+
+        cumulative += dw;
+    }
+
+    const auto& last = centroids.back();
+    auto t = std::min((index - cumulative)/(0.5*last.weight), 1.0);
+
+    return last.mean + t*(max - last.mean);
+}
+
+
+double TDigest::cdf(const double value)
+{
+    this->flush();
+
+    if(centroids.empty())
+        return std::numeric_limits<double>::quiet_NaN();
+
+    if(value < min)
+        return 0.0;
+
+    if(value >= max)
+        return 1.0;
+
+    const auto& first = centroids.front();
+    if(value < first.mean)
+        return 0.5*first.weight*(value - min)/(first.mean - min)/totalWeight;
+
+    auto cumulative = 0.5*first.weight;
+    for(size_t i = 0; i+1<centroids.size(); ++i)
+    {
+        auto dw = 0.5*(centroids[i].weight + centroids[i+1].weight);
+
+        if(value < centroids[i+1].mean)
+        {
+            auto t = (value - centroids[i].mean)/(centroids[i+1].mean - centroids[i].mean);
+            return (cumulative + t*dw)/totalWeight;
+        }
+
+        cumulative += dw;
+    }
+
+    const auto& last = centroids.back();
+
+    return (cumulative + 0.5*last.weight*(value - last.mean)/(max - last.mean))/totalWeight;
+}
+
+
+double TDigest::getTotalWeight(void) const
+{
+    return totalWeight;
+}
+
+
+double TDigest::getCompression(void) const
+{
+    return compression;
+}
+
+
+double TDigest::getMin(void) const
+{
+    return min;
+}
+
+
+double TDigest::getMax(void) const
+{
+    return max;
+}
+
+
+const std::vector<TDigest::Centroid>& TDigest::getCentroids(void)
+{
+    this->flush();
+
+    return centroids;
+}
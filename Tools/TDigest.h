@@ -0,0 +1,91 @@
+#ifndef TDIGEST_H
+#define TDIGEST_H
+/* *****************************************************************************
+Copyright (c) 2016-2021, The Regents of the University of California (Regents).
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those
+of the authors and should not be interpreted as representing official policies,
+either expressed or implied, of the FreeBSD Project.
+
+REGENTS SPECIFICALLY DISCLAIMS ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+THE SOFTWARE AND ACCOMPANYING DOCUMENTATION, IF ANY, PROVIDED HEREUNDER IS
+PROVIDED "AS IS". REGENTS HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+
+*************************************************************************** */
+
+
+#include <vector>
+
+// Bounded memory sketch of a distribution for estimating quantiles, the merging t-digest of Dunning and Ertl (2019)
+// The samples are summarized by weighted centroids that are small near the tails and large near the median, so that the extreme quantiles stay accurate
+// The number of centroids is bounded by the compression, regardless of the number of samples
+class TDigest
+{
+public:
+
+    struct Centroid
+    {
+        double mean;
+        double weight;
+    };
+
+    explicit TDigest(const double compression = 100.0);
+
+    void add(const double value, const double weight = 1.0);
+
+    void clear(void);
+
+    // Returns the estimated value at the probability 0 <= p <= 1, or NaN if there are no samples
+    double quantile(const double p);
+
+    // Returns the estimated fraction of the samples that are less than or equal to the value, or NaN if there are no samples
+    double cdf(const double value);
+
+    double getTotalWeight(void) const;
+
+    double getCompression(void) const;
+
+    double getMin(void) const;
+    double getMax(void) const;
+
+    const std::vector<Centroid>& getCentroids(void);
+
+private:
+
+    // Merges the buffered samples into the centroids
+    void flush(void);
+
+    double compression;
+
+    std::vector<Centroid> centroids;
+    std::vector<Centroid> buffer;
+
+    double totalWeight;
+    double min;
+    double max;
+};
+
+#endif // TDIGEST_H
@@ -41,7 +41,7 @@ UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 #include "QGISVisualizationWidget.h"
 #include <qgsvectorlayer.h>
 
-#include <QtXml>
+#include <QXmlStreamReader>
 #include <QFile>
 
 XMLAdaptor::XMLAdaptor()
@@ -52,8 +52,7 @@ XMLAdaptor::XMLAdaptor()
 
 QgsVectorLayer* XMLAdaptor::parseXMLFile(const QString& filePath, QString& errMessage, QGISVisualizationWidget* GISVisWidget)
 {
-    // QDomDocument used to import XML data
-    QDomDocument xmlGMs;
+    gridData = ShakeMapGridData();
 
     // Load xml file
     QFile file(filePath);
@@ -64,135 +63,131 @@ QgsVectorLayer* XMLAdaptor::parseXMLFile(const QString& filePath, QString& errMe
         return nullptr;
     }
 
-    // Set raw XML content into the QDomDocument
-    xmlGMs.setContent(&file);
-
-    // Close the file now that we are done with it
-    file.close();
-
-    // Extract the root element
-    QDomElement root=xmlGMs.documentElement();
-
-    // Get root names and attributes
-    QString Type = root.tagName();
+    // The file is read as a stream so that neither the document tree nor a copy of the grid text is held in memory
+    QXmlStreamReader xml(&file);
 
     // Check that the XML file is actually a shake map grid
-    if(Type.compare("shakemap_grid") != 0)
+    if(!xml.readNextStartElement() || xml.name() != QLatin1String("shakemap_grid"))
     {
         errMessage = "Error, XML file is not a ShakeMap grid";
         return nullptr;
     }
 
     // Get some information from the file
-    shakemapID = root.attribute("shakemap_id","NULL");
-
-    //    QString shakemapVersion = root.attribute("shakemap_version","NULL");
+    shakemapID = xml.attributes().hasAttribute("shakemap_id") ? xml.attributes().value("shakemap_id").toString() : QString("NULL");
 
-    //    if(shakemapVersion.compare("10") != 0)
-    //    {
-    //        errMessage = "Error: only shakemap version 10 is supported";
-    //        return nullptr;
-    //    }
+    bool foundEvent = false;
+    int numGridData = 0;
 
-    QDomNodeList eventList = root.elementsByTagName("event");
-
-    QDomNodeList GMFieldsList = root.elementsByTagName("grid_field");
+    while(!xml.atEnd())
+    {
+        xml.readNext();
 
-    auto numFields = GMFieldsList.size();
+        if(!xml.isStartElement())
+            continue;
 
-    if(numFields == 0 || eventList.size() == 0)
-        return nullptr;
+        auto elementName = xml.name();
 
-    // Get the event name
-    eventName = eventList.item(0).toElement().attribute("event_description","NULL");
+        if(elementName == QLatin1String("event"))
+        {
+            if(!foundEvent)
+            {
+                auto attributes = xml.attributes();
+                eventName = attributes.hasAttribute("event_description") ? attributes.value("event_description").toString() : QString("NULL");
+            }
 
-    int indexLon = -1;
-    int indexLat = -1;
+            foundEvent = true;
+        }
+        else if(elementName == QLatin1String("grid_field"))
+        {
+            auto attributes = xml.attributes();
+            QString fieldName = attributes.hasAttribute("name") ? attributes.value("name").toString() : QString("NULL");
 
-    // Get all of the grid fields from the XML file
-    QgsFields featFields;
+            if(fieldName.compare("LAT") == 0)
+                gridData.latIndex = gridData.fieldNames.size();
+            if(fieldName.compare("LON") == 0)
+                gridData.lonIndex = gridData.fieldNames.size();
 
-    QList<QgsField> attribFields;
-    attribFields.push_back(QgsField("AssetType", QVariant::String));
-    attribFields.push_back(QgsField("TabName", QVariant::String));
-
-    featFields.append(QgsField("AssetType", QVariant::String));
-    featFields.append(QgsField("TabName", QVariant::String));
+            gridData.fieldNames.append(fieldName);
+        }
+        else if(elementName == QLatin1String("grid_data"))
+        {
+            ++numGridData;
+
+            if(numGridData > 1)
+                break;
+
+            if(gridData.fieldNames.isEmpty() || !foundEvent)
+                return nullptr;
+
+            if(gridData.latIndex == -1 || gridData.lonIndex == -1)
+            {
+                errMessage = "Error getting the lat and/or lon indexes in the grid xml file";
+                return nullptr;
+            }
+
+            // The text of the grid data may come in several pieces, each piece is tokenized as it arrives
+            QString partialToken;
+            int numInLine = 0;
+
+            while(!xml.atEnd())
+            {
+                auto token = xml.readNext();
+
+                if(token == QXmlStreamReader::Characters)
+                {
+                    if(!this->tokenizeGridText(xml.text(), partialToken, numInLine, errMessage))
+                        return nullptr;
+                }
+                else if(token == QXmlStreamReader::EndElement)
+                {
+                    break;
+                }
+            }
+
+            if(!partialToken.isEmpty() && !this->addGridToken(QStringRef(&partialToken), numInLine, errMessage))
+                return nullptr;
+
+            if(!this->endGridLine(numInLine, errMessage))
+                return nullptr;
+        }
+    }
 
-    for(int i = 0; i < GMFieldsList.count(); ++i)
+    if(xml.hasError())
     {
-        auto item = GMFieldsList.item(i).toElement();
-
-        QString fieldName = item.attribute("name","NULL");
-        attribFields.push_back(QgsField(fieldName, QVariant::String));
-
-        featFields.append(QgsField(fieldName, QVariant::String));
-
-        if(fieldName.compare("LAT") == 0)
-            indexLat = i;
-        if(fieldName.compare("LON") == 0)
-            indexLon = i;
+        errMessage = "Error parsing the ShakeMap grid: " + xml.errorString();
+        return nullptr;
     }
 
-    // Get the grid data from the XML file
-    QDomNodeList gridDataElements = root.elementsByTagName("grid_data");
+    // Close the file now that we are done with it
+    file.close();
 
-    if(gridDataElements.size() != 1)
+    if(numGridData != 1)
     {
         errMessage = "Error, no grid data in XML file";
         return nullptr;
     }
 
-    auto gridData =  gridDataElements.at(0).toElement().text();
-
-    // Each grid point is separated by a newline
-    auto gridPoints = gridData.split("\n",Qt::SkipEmptyParts);
+    auto numFields = gridData.fieldNames.size();
+    auto numPoints = gridData.numPoints();
 
-    if(gridPoints.size() == 0)
+    if(numPoints == 0)
         return nullptr;
 
-    if(indexLat == -1 || indexLon == -1)
-    {
-        errMessage = "Error getting the lat and/or lon indexes in the grid xml file";
-        return nullptr;
-    }   
-
-//    // Over 50000 points causes arc gis library to crash... even though, too many points makes the visualization too cluttered
-//    int decim = gridPoints.size()/40000;
+    // Get all of the grid fields from the XML file
+    QList<QgsField> attribFields;
+    attribFields.push_back(QgsField("AssetType", QVariant::String));
+    attribFields.push_back(QgsField("TabName", QVariant::String));
 
-//    if(decim == 0)
-//        decim = 1;
+    for(auto&& fieldName : gridData.fieldNames)
+        attribFields.push_back(QgsField(fieldName, QVariant::Double));
 
-    // Iterate through the grid points to get the data at each point
+    // Iterate through the grid points to create a feature at each point
     QgsFeatureList featureList;
+    featureList.reserve(numPoints);
 
-    auto count = 0;
-    for(auto&& gp : gridPoints)
+    for(int p = 0; p<numPoints; ++p)
     {
-        ++count;
-
-//        if(count%decim != 0)
-//            continue;
-
-        // Change for windows compilation
-        gp.remove("\r");
-
-        if(gp.isEmpty())
-            continue;
-
-        QStringList pointData;
-
-        if(gp.contains("\t"))
-            pointData = gp.split("\t");
-        else
-            pointData = gp.split(" ");
-
-        if(pointData.size() != numFields)
-        {
-            errMessage = "Error the number of columns in a point does not equal the number of fields";
-            return nullptr;
-        }
-
         // create the feature attributes
         QgsAttributes featAttributes(attribFields.size());
 
@@ -200,46 +195,13 @@ QgsVectorLayer* XMLAdaptor::parseXMLFile(const QString& filePath, QString& errMe
         featAttributes[1]= "ShakeMap Grid Point"; // Tab Name
 
         for(int i = 0; i<numFields; ++i)
-        {
-            auto attrbVal = pointData[i];
-            featAttributes[2+i] = attrbVal;
-        }
-
-        bool OK = true;
-
-        auto longitude = pointData[indexLon].toDouble(&OK);
-
-        if(!OK)
-        {
-            errMessage = "Error converting longitude to double";
-            return nullptr;
-        }
-
-        auto latitude = pointData[indexLat].toDouble(&OK);
-
-        if(!OK)
-        {
-            errMessage = "Error converting latitude to double";
-            return nullptr;
-        }
-
-        if(longitude == 0.0 || latitude == 0.0)
-        {
-            errMessage = "Error, zero lat lon values";
-            return nullptr;
-        }
+            featAttributes[2+i] = gridData.value(p,i);
 
         // Create the feature
         QgsFeature feature;
-        feature.setFields(featFields);
-        feature.setGeometry(QgsGeometry::fromPointXY(QgsPointXY(longitude,latitude)));
+        feature.setGeometry(QgsGeometry::fromPointXY(QgsPointXY(gridData.longitude(p),gridData.latitude(p))));
         feature.setAttributes(featAttributes);
         featureList.append(feature);
-
-        // Create the ground motion station
-        GroundMotionStation station("NULL",latitude,longitude);
-        station.setStationFeature(feature);
-        stationList.push_back(station);
     }
 
 
@@ -271,13 +233,123 @@ QgsVectorLayer* XMLAdaptor::parseXMLFile(const QString& filePath, QString& errMe
 }
 
 
+bool XMLAdaptor::tokenizeGridText(const QStringRef& text, QString& partialToken, int& numInLine, QString& errMessage)
+{
+    auto isSeparator = [](const QChar c) {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+    };
+
+    int tokenBegin = 0;
+    auto size = text.size();
+
+    for(int i = 0; i<=size; ++i)
+    {
+        if(i < size && !isSeparator(text.at(i)))
+            continue;
+
+        // A token that began in a previous piece of the text
+        if(!partialToken.isEmpty())
+        {
+            if(i == size)
+            {
+                partialToken += text.mid(tokenBegin, i-tokenBegin);
+                return true;
+            }
+
+            partialToken += text.mid(tokenBegin, i-tokenBegin);
+
+            if(!this->addGridToken(QStringRef(&partialToken), numInLine, errMessage))
+                return false;
+
+            partialToken.clear();
+        }
+        else if(i > tokenBegin)
+        {
+            // The last token may continue in the next piece of the text
+            if(i == size)
+            {
+                partialToken = text.mid(tokenBegin).toString();
+                return true;
+            }
+
+            if(!this->addGridToken(text.mid(tokenBegin, i-tokenBegin), numInLine, errMessage))
+                return false;
+        }
+
+        // Each grid point is separated by a newline
+        if(i < size && text.at(i) == '\n' && !this->endGridLine(numInLine, errMessage))
+            return false;
+
+        tokenBegin = i+1;
+    }
+
+    return true;
+}
+
+
+bool XMLAdaptor::addGridToken(const QStringRef& token, int& numInLine, QString& errMessage)
+{
+    if(numInLine == gridData.fieldNames.size())
+    {
+        errMessage = "Error the number of columns in a point does not equal the number of fields";
+        return false;
+    }
+
+    bool OK = true;
+    auto val = token.toDouble(&OK);
+
+    if(!OK)
+    {
+        if(numInLine == gridData.lonIndex)
+            errMessage = "Error converting longitude to double";
+        else if(numInLine == gridData.latIndex)
+            errMessage = "Error converting latitude to double";
+        else
+            errMessage = "Error converting the grid value " + token.toString() + " to double";
+
+        return false;
+    }
+
+    gridData.values.append(val);
+    ++numInLine;
+
+    return true;
+}
+
+
+bool XMLAdaptor::endGridLine(int& numInLine, QString& errMessage)
+{
+    // Skip empty lines
+    if(numInLine == 0)
+        return true;
+
+    if(numInLine != gridData.fieldNames.size())
+    {
+        errMessage = "Error the number of columns in a point does not equal the number of fields";
+        return false;
+    }
+
+    auto point = gridData.numPoints()-1;
+
+    if(gridData.longitude(point) == 0.0 || gridData.latitude(point) == 0.0)
+    {
+        errMessage = "Error, zero lat lon values";
+        return false;
+    }
+
+    numInLine = 0;
+
+    return true;
+}
+
+
 QString XMLAdaptor::getEventName() const
 {
     return eventName;
 }
 
 
-QVector<GroundMotionStation> XMLAdaptor::getStationList() const
+const ShakeMapGridData& XMLAdaptor::getGridData() const
 {
-    return stationList;
+    return gridData;
 }
@@ -40,13 +40,51 @@ UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 
 // This class imports a XML ShakeMap grid into a ArcGIS feature collection layer
 
-#include "GroundMotionStation.h"
-
 #include <QString>
+#include <QStringList>
+#include <QVector>
 
 class QObject;
 class QGISVisualizationWidget;
 class QgsVectorLayer;
+
+// The grid points of a ShakeMap, stored as one row of values per point in the order of the grid fields
+struct ShakeMapGridData
+{
+    QStringList fieldNames;
+
+    QVector<double> values;
+
+    int latIndex = -1;
+    int lonIndex = -1;
+
+    inline int numPoints(void) const
+    {
+        return fieldNames.isEmpty() ? 0 : values.size()/fieldNames.size();
+    }
+
+    inline int fieldIndex(const QString& fieldName) const
+    {
+        return fieldNames.indexOf(fieldName);
+    }
+
+    inline double value(const int point, const int field) const
+    {
+        return values.at(point*fieldNames.size() + field);
+    }
+
+    inline double latitude(const int point) const
+    {
+        return this->value(point, latIndex);
+    }
+
+    inline double longitude(const int point) const
+    {
+        return this->value(point, lonIndex);
+    }
+};
+
+
 class XMLAdaptor
 {
 public:
@@ -56,14 +94,22 @@ public:
 
     QString getEventName() const;
 
-    QVector<GroundMotionStation> getStationList() const;
+    const ShakeMapGridData& getGridData() const;
 
 private:
+
+    // Splits the text of the grid data into numbers, a number that is cut off at the end of the text is kept in partialToken for the next call
+    bool tokenizeGridText(const QStringRef& text, QString& partialToken, int& numInLine, QString& errMessage);
+
+    bool addGridToken(const QStringRef& token, int& numInLine, QString& errMessage);
+
+    bool endGridLine(int& numInLine, QString& errMessage);
+
     QString eventName;
 
     QString shakemapID;
 
-    QVector<GroundMotionStation> stationList;
+    ShakeMapGridData gridData;
 };
 
 #endif // XMLADAPTOR_H
@@ -41,6 +41,7 @@ UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 #include "AssetInputWidget.h"
 #include "VisualizationWidget.h"
 #include "CSVReaderWriter.h"
+#include "ColumnarTable.h"
 #include "ComponentTableView.h"
 #include "ComponentTableModel.h"
 #include "ComponentDatabaseManager.h"
@@ -144,7 +145,7 @@ bool AssetInputWidget::loadAssetData(bool message)
     CSVReaderWriter csvTool;
     
     QString err;
-    QVector<QStringList> data = csvTool.parseCSVFile(pathToComponentInputFile,err);
+    ColumnarTable data = csvTool.parseCSVFileToTable(pathToComponentInputFile,err);
     
     if(!err.isEmpty())
     {
@@ -152,14 +153,14 @@ bool AssetInputWidget::loadAssetData(bool message)
         return false;
     }
     
-    if(data.empty())
+    if(data.columnCount() == 0)
     {
         this->errorMessage("Input file is empty");
         return false;
     }
     
     // Get the header file
-    QStringList tableHeadings = data.first();
+    QStringList tableHeadings = data.getHeader();
     
     tableHorizontalHeadings = tableHeadings;
     
@@ -167,10 +168,7 @@ bool AssetInputWidget::loadAssetData(bool message)
     
     emit headingValuesChanged(tableHeadings);
     
-    // Pop off the row that contains the header information
-    data.pop_front();
-    
-    auto numRows = data.size();
+    auto numRows = data.rowCount();
     
     if(numRows == 0)
     {
@@ -182,15 +180,13 @@ bool AssetInputWidget::loadAssetData(bool message)
         QApplication::processEvents();
     }
     
-    auto firstRow = data.first();
-    
-    if(firstRow.empty())
+    if(data.isRowNull(0))
     {
         this->errorMessage("First row is empty");
         return false;
     }
     
-    componentTableWidget->getTableModel()->populateData(data, tableHorizontalHeadings);
+    componentTableWidget->getTableModel()->populateData(std::move(data));
 
 #ifdef OpenSRA
     label3->show();
@@ -513,16 +509,15 @@ void AssetInputWidget::handleComponentSelection(void)
 
     auto selectedComponentIDs = selectComponentsLineEdit->getSelectedComponentIDs();
 
-    // First check that all of the selected IDs are within range
-    for(auto&& it : selectedComponentIDs)
+    // First check that all of the selected IDs are within range, the set is sorted so only the ends need to be checked
+    if(!selectedComponentIDs.empty() && (selectedComponentIDs.min()<firstID || selectedComponentIDs.max()>lastID))
     {
-        if(it<firstID || it>lastID)
-        {
-            QString msg = "The component ID " + QString::number(it) + " is out of range of the components provided";
-            this->errorMessage(msg);
-            selectComponentsLineEdit->clear();
-            return;
-        }
+        auto outOfRangeID = selectedComponentIDs.min()<firstID ? selectedComponentIDs.min() : selectedComponentIDs.max();
+
+        QString msg = "The component ID " + QString::number(outOfRangeID) + " is out of range of the components provided";
+        this->errorMessage(msg);
+        selectComponentsLineEdit->clear();
+        return;
     }
 
     theComponentDb->startEditing();
@@ -549,14 +544,12 @@ void AssetInputWidget::handleComponentSelection(void)
 
     theComponentDb->commitChanges();
 
-    // Hide all of the rows that are not selecetd. Takes a long time!
-    //    // Hide all rows in the table
-    //    for(int i = 0; i<nRows; ++i)
-    //        componentTableWidget->setRowHidden(i,true);
+    // Hide all of the rows that are not selected, the rows are filtered in the proxy model in a single pass
+    ComponentIDSet selectedRows;
+    for(auto&& range : selectedComponentIDs.getRanges())
+        selectedRows.insertRange(range.first - firstID, range.last - firstID);
 
-    //    // Unhide the selected rows
-    //    for(auto&& it : selectedComponentIDs)
-    //        componentTableWidget->setRowHidden(it - firstID,false);
+    componentTableWidget->setVisibleRows(selectedRows);
 
 
 }
@@ -571,13 +564,8 @@ QStringList AssetInputWidget::getTableHorizontalHeadings()
 
 void AssetInputWidget::clearComponentSelection(void)
 {
-    //    auto nRows = componentTableWidget->rowCount();
-
-    // Hide all rows in the table
-    //    for(int i = 0; i<nRows; ++i)
-    //    {
-    //        componentTableWidget->setRowHidden(i,false);
-    //    }
+    // Show all of the rows in the table
+    componentTableWidget->clearVisibleRows();
 
     selectComponentsLineEdit->clear();
 
@@ -881,11 +869,7 @@ bool AssetInputWidget::copyFiles(QString &destName)
     if(nRows == 0)
         return false;
 
-    auto data = componentTableWidget->getTableModel()->getTableData();
-
-    auto headerValues = componentTableWidget->getTableModel()->getHeaderStringList();
-
-    data.push_front(headerValues);
+    const auto& data = componentTableWidget->getTableModel()->getTable();
 
     CSVReaderWriter csvTool;
 
@@ -994,11 +978,11 @@ void AssetInputWidget::handleCellChanged(const int row, const int col)
 
     auto attribVal = componentTableWidget->item(row,col);
 
+    QString err;
+    auto res = theComponentDb->updateComponentAttributes({{ID,attrib,attribVal}}, err);
 
-    auto res = theComponentDb->updateComponentAttribute(ID,attrib,attribVal);
     if(res == false)
-        this->errorMessage("Error could not update asset "+QString::number(ID)+" after cell change");
-
+        this->errorMessage("Error could not update asset "+QString::number(ID)+" after cell change: "+err);
 }
 
 
@@ -45,6 +45,7 @@ UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 #include "ComponentDatabaseManager.h"
 #include "CRSSelectionWidget.h"
 #include "CSVReaderWriter.h"
+#include "ColumnarTable.h"
 
 #include "QGISVisualizationWidget.h"
 
@@ -361,12 +362,14 @@ bool GISAssetInputWidget::loadAssetData(bool message)
     }
 
     QStringList fieldsStrList;
+    QVector<ColumnarTable::ColumnType> fieldTypes;
     for(int i = 0; i<fields.size(); ++i)
     {
         auto field = fields[i];
         auto fieldName = field.name();
 
         fieldsStrList.push_back(fieldName);
+        fieldTypes.push_back(ColumnarTable::columnTypeFor(field.type()));
     }
 
     // Add the ID column to the headers
@@ -376,38 +379,26 @@ bool GISAssetInputWidget::loadAssetData(bool message)
 
     auto numFields = fieldsStrList.size();
 
-    // Data containing the table
-    QVector<QStringList> data(numFeat);
+    // Data containing the table, the attributes are stored with the types of the layer fields
+    ColumnarTable data;
+    data.setHeader(fieldsStrList, fieldTypes);
+    data.reserve(numFeat);
 
     // Test to remove
     // auto start = high_resolution_clock::now();
 
     QgsFeature feat;
-    int i = 0;
     while (features.nextFeature(feat))
     {
-        //QStringList attributeStrList = {QString::number(i+1)};
-        QStringList attributeStrList;
-//        attributeStrList.push_back(QString::number(i));
-
         auto attributes = feat.attributes();
-        for(int i = 0; i<attributes.size(); ++i)
-        {
-            auto attribute = attributes[i];
-            auto attributeStr = attribute.toString();
 
-            attributeStrList.push_back(attributeStr);
-        }
-
-        if(attributeStrList.size() != numFields)
+        if(attributes.size() != numFields)
         {
-            this->errorMessage("Error, the number of attributes: "+QString::number(attributeStrList.size())+" for feature " +QString::number(feat.id())+" does not equal the number of fields "+QString::number(numFields));
+            this->errorMessage("Error, the number of attributes: "+QString::number(attributes.size())+" for feature " +QString::number(feat.id())+" does not equal the number of fields "+QString::number(numFields));
             return false;
         }
 
-        data[i] = attributeStrList;
-
-        ++i;
+        data.appendRow(attributes);
     }
 
     // Test to remove
@@ -416,7 +407,7 @@ bool GISAssetInputWidget::loadAssetData(bool message)
     //    this->statusMessage("Done shapefile results "+QString::number(duration.count()));
 
     componentTableWidget->clear();
-    componentTableWidget->getTableModel()->populateData(data, tableHorizontalHeadings);
+    componentTableWidget->getTableModel()->populateData(std::move(data));
 #ifdef OpenSRA
     label3->show();
 #endif
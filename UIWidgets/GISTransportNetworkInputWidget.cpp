@@ -39,14 +39,21 @@ UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 #include "GISTransportNetworkInputWidget.h"
 #include "QGISVisualizationWidget.h"
 #include "GISAssetInputWidget.h"
+#include "GeoJSONReaderWriter.h"
 
 #include <qgslinesymbol.h>
 #include <qgsmarkersymbol.h>
+#include <qgsexception.h>
 
 #include <QFileDialog>
 #include <QSplitter>
 #include <QGroupBox>
 #include <QVBoxLayout>
+#include <QFile>
+#include <QDir>
+#include <QLocale>
+
+#include <cmath>
 
 GISTransportNetworkInputWidget::GISTransportNetworkInputWidget(QWidget *parent, VisualizationWidget* visWidget) : SimCenterAppWidget(parent)
 {
@@ -137,44 +144,47 @@ bool GISTransportNetworkInputWidget::copyFiles(QString &destName)
         return false;
     }
     destFolder = destName;
-    QJsonArray featuresArray;
-    QJsonObject combinedGeoJSON;
-    combinedGeoJSON["type"]="FeatureCollection";
 
-    QString crsString = R"(
-        {
-            "type": "name",
-            "properties": {
-                "name": "urn:ogc:def:crs:OGC:1.3:CRS84"
-            }
-        }
-    )";
-    QJsonDocument crsDoc = QJsonDocument::fromJson(crsString.toUtf8());
-    QJsonObject crsJson = crsDoc.object();
-    combinedGeoJSON.insert("crs", crsJson);
+    QString destFile = destFolder + QDir::separator() + tr("simcenter_trnsp_inventory.geojson");
+    QFile file(destFile);
+    if (!file.open(QFile::WriteOnly | QFile::Text)) {
+        this->errorMessage("Error creating the file "+destFile+" in the transportation network widget");
+        return false;
+    }
+
+    // Stream the features of all the layers into one feature collection
+    QByteArray buffer("{\n\"type\": \"FeatureCollection\",\n"
+                      "\"crs\": {\"type\": \"name\", \"properties\": {\"name\": \"urn:ogc:def:crs:OGC:1.3:CRS84\"}},\n"
+                      "\"features\": [\n");
+
+    int numFeatures = 0;
+
     if(theBridgesWidget->getSelectedLayer() != nullptr){
         QgsVectorLayer* layer = theBridgesWidget->getSelectedLayer();
         QString type = "Bridge";
-        exportLayerToGeoJSON(layer, featuresArray, type);
+        if(!exportLayerToGeoJSON(layer, file, buffer, numFeatures, type))
+            return false;
     }
     if(theRoadwaysWidget->getSelectedLayer() != nullptr){
         QgsVectorLayer* layer = theRoadwaysWidget->getSelectedLayer();
         QString type = "Roadway";
-        exportLayerToGeoJSON(layer, featuresArray, type);
+        if(!exportLayerToGeoJSON(layer, file, buffer, numFeatures, type))
+            return false;
     }
     if(theTunnelsWidget->getSelectedLayer() != nullptr){
         QgsVectorLayer* layer = theTunnelsWidget->getSelectedLayer();
         QString type = "Tunnel";
-        exportLayerToGeoJSON(layer, featuresArray, type);
+        if(!exportLayerToGeoJSON(layer, file, buffer, numFeatures, type))
+            return false;
     }
-    combinedGeoJSON.insert("features", featuresArray);
-    QString destFile = destFolder + QDir::separator() + tr("simcenter_trnsp_inventory.geojson");
-    QFile file(destFile);
-    if (!file.open(QFile::WriteOnly | QFile::Text)) {
+
+    buffer.append("\n]\n}\n");
+
+    if(file.write(buffer) != buffer.size()) {
+        this->errorMessage("Error writing the file "+destFile+": "+file.errorString());
         return false;
     }
-    QJsonDocument doc(combinedGeoJSON);
-    file.write(doc.toJson());
+
     file.close();
 
     return true;
@@ -182,42 +192,137 @@ bool GISTransportNetworkInputWidget::copyFiles(QString &destName)
 
 }
 
-void GISTransportNetworkInputWidget::exportLayerToGeoJSON(QgsVectorLayer* layer, QJsonArray& featArray, QString assetType){
-    QgsJsonExporter exporter = QgsJsonExporter(layer);
-    QgsCoordinateReferenceSystem source_crs = layer->sourceCrs();
+
+bool GISTransportNetworkInputWidget::exportLayerToGeoJSON(QgsVectorLayer* layer, QIODevice& out, QByteArray& buffer, int& numFeatures, const QString& assetType){
+
+    // Same number of decimals as the QgsJsonExporter default
+    const int precision = 6;
+
+    // Flush the buffer to the device every MB
+    const int flushSize = 1 << 20;
+
+    GeoJSONReaderWriter jsonWriter;
+
+    // The features come out of the iterator in the layer CRS, set up a single transform for the whole layer
+    QgsCoordinateReferenceSystem source_crs = layer->crs();
     QgsCoordinateReferenceSystem target_crs = QgsCoordinateReferenceSystem("EPSG:4326");
     bool need_reproject = (source_crs.toWkt() != target_crs.toWkt());
+    QgsCoordinateTransform transform(source_crs, target_crs, QgsProject::instance());
+
+    // The property keys are the same for every feature, escape them once
+    const auto fields = layer->fields();
+    QVector<QByteArray> propertyKeys(fields.size());
+    for(int i = 0; i<fields.size(); ++i)
+    {
+        // The asset type replaces any existing type attribute
+        if(fields.at(i).name() == QLatin1String("type"))
+            continue;
+
+        jsonWriter.appendJsonString(propertyKeys[i], fields.at(i).name());
+        propertyKeys[i].append(':');
+    }
+
+    QByteArray typeProperty("\"type\":");
+    jsonWriter.appendJsonString(typeProperty, assetType);
+
     QgsFeatureIterator featIt = layer->getFeatures();
     QgsFeature feat;
-    if (need_reproject){
-        while (featIt.nextFeature(feat))
+    while (featIt.nextFeature(feat))
+    {
+        if(numFeatures > 0)
+            buffer.append(",\n");
+
+        buffer.append("{\"type\":\"Feature\",\"id\":");
+        buffer.append(QByteArray::number(feat.id()));
+        buffer.append(",\"geometry\":");
+
+        QgsGeometry geom = feat.geometry();
+        if(geom.isNull())
+        {
+            buffer.append("null");
+        }
+        else
+        {
+            if(need_reproject)
+            {
+                try
+                {
+                    geom.transform(transform);
+                }
+                catch (QgsCsException &e)
+                {
+                    this->errorMessage("Error transforming the geometry of feature "+QString::number(feat.id())+" in the "+assetType+" layer: "+e.what());
+                    return false;
+                }
+            }
+
+            buffer.append(geom.asJson(precision).toUtf8());
+        }
+
+        // Each attribute is a feature property
+        buffer.append(",\"properties\":{");
+
+        const auto attributes = feat.attributes();
+        for(int i = 0; i<attributes.size() && i<propertyKeys.size(); ++i)
         {
-            auto newFeat = QgsFeature(feat); // Use the feature copy constructor
-            // Do a deep clone of the geometry
-            QgsGeometry newGeom = QgsGeometry(feat.geometry().get()->clone());
-            newGeom.transform(QgsCoordinateTransform(source_crs, target_crs, QgsProject::instance()));
-            newFeat.setGeometry(newGeom);
-            QString featData = exporter.exportFeature(newFeat);
-            QJsonDocument doc = QJsonDocument::fromJson(featData.toUtf8());
-            QJsonObject featJSON = doc.object();
-            QJsonObject prop = featJSON["properties"].toObject();
-            prop.insert("type",assetType);
-            featJSON["properties"] = prop;
-            featArray.append(featJSON);
+            if(propertyKeys.at(i).isEmpty())
+                continue;
+
+            buffer.append(propertyKeys.at(i));
+
+            const auto& val = attributes.at(i);
+            if(val.isNull())
+            {
+                buffer.append("null");
+            }
+            else
+            {
+                switch(val.type())
+                {
+                case QVariant::Int:
+                case QVariant::UInt:
+                case QVariant::LongLong:
+                case QVariant::ULongLong:
+                    buffer.append(val.toString().toLatin1());
+                    break;
+                case QVariant::Double:
+                {
+                    auto dblVal = val.toDouble();
+                    // The shortest text that reads back to the same value
+                    if(std::isfinite(dblVal))
+                        buffer.append(QByteArray::number(dblVal, 'g', QLocale::FloatingPointShortest));
+                    else
+                        buffer.append("null");
+                    break;
+                }
+                case QVariant::Bool:
+                    buffer.append(val.toBool() ? "true" : "false");
+                    break;
+                default:
+                    jsonWriter.appendJsonString(buffer, val.toString());
+                }
+            }
+
+            buffer.append(',');
         }
-    } else {
-        while (featIt.nextFeature(feat))
+
+        buffer.append(typeProperty);
+        buffer.append("}}");
+
+        ++numFeatures;
+
+        if(buffer.size() >= flushSize)
         {
-            QString featData = exporter.exportFeature(feat);
-            QJsonDocument doc = QJsonDocument::fromJson(featData.toUtf8());
-            QJsonObject featJSON = doc.object();
-            QJsonObject prop = featJSON["properties"].toObject();
-            prop.insert("type",assetType);
-            featJSON["properties"] = prop;
-            featArray.append(featJSON);
+            if(out.write(buffer) != buffer.size())
+            {
+                this->errorMessage("Error writing the "+assetType+" features: "+out.errorString());
+                return false;
+            }
+            buffer.clear();
         }
     }
 
+    return true;
 }
 
 
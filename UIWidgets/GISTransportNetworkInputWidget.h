@@ -60,6 +60,7 @@ class GISAssetInputWidget;
 class QgsVectorLayer;
 class QgsFeature;
 class QgsGeometry;
+class QIODevice;
 
 class GISTransportNetworkInputWidget : public SimCenterAppWidget
 {
@@ -96,7 +97,8 @@ protected:
     QgsVectorLayer* roadwaysMainLayer = nullptr;
     QgsVectorLayer* tunnelsMainLayer = nullptr;
 
-    void exportLayerToGeoJSON(QgsVectorLayer* layer, QJsonArray& featArray,QString assetType);
+    // Serializes the features of the layer directly into the buffer in EPSG:4326, flushing it to the device as it fills
+    bool exportLayerToGeoJSON(QgsVectorLayer* layer, QIODevice& out, QByteArray& buffer, int& numFeatures, const QString& assetType);
 private:
 //    QLineEdit *roadLengthLineEdit;
 //    QWidget* roadLengthWidget = nullptr;
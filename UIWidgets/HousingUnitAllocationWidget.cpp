@@ -46,6 +46,7 @@ UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 #include <Utils/ProgramOutputDialog.h>
 #include "NetworkDownloadManager.h"
 #include "ZipUtils.h"
+#include "SpatialBoxIndex.h"
 
 #include <QDir>
 #include <QApplication>
@@ -236,31 +237,15 @@ std::set<QString> HousingUnitAllocationWidget::getCountiesFromBuildingInventory(
     }
 
 
-    // Create a cache to store the counties, since many buildings can be in multiple counties
-    QVector<QgsFeature> countyVecCache;
+    // Index the county bounding boxes so that each building is only tested against the counties whose boxes contain it
+    SpatialBoxIndex countyIndex;
+    for(int i = 0; i<countyFeatVec.size(); ++i)
+        countyIndex.insert(i, countyFeatVec.at(i).geometry().boundingBox());
 
 
     // Iterate through the building features
     auto features = assetLayer->getFeatures();
 
-    auto testInPolygon = [](const QgsGeometry& countyGeom, const QgsPointXY& buildCentroid, QgsGeometryEngine* polygonGeometryEngine) -> bool
-    {
-
-        // Do initial bounding box check which is very fast to exclude points that are far away
-        auto bb = countyGeom.boundingBox();
-
-        if(bb.contains(buildCentroid))
-        {
-            if(polygonGeometryEngine->intersects(countyGeom.constGet()))
-            {
-                return true;
-            }
-        }
-
-        return false;
-    };
-
-
     QgsFeature feat;
     while (features.nextFeature(feat))
     {
@@ -281,49 +266,21 @@ std::set<QString> HousingUnitAllocationWidget::getCountiesFromBuildingInventory(
 
         bool found = false;
 
-        // First check the cache
-        auto countyIt = countyVecCache.constBegin();
-        while(countyIt != countyVecCache.constEnd())
+        auto candidates = countyIndex.candidatesContaining(buildCentroid);
+        for(auto&& countyIdx : candidates)
         {
-            auto countyGeom = countyIt->geometry();
+            const auto& county = countyFeatVec.at(countyIdx);
 
-            if(testInPolygon(countyGeom,buildCentroid,polygonGeometryEngine.get()) == true)
+            if(polygonGeometryEngine->intersects(county.geometry().constGet()))
             {
-
-                auto countyIDidx = countyIt->fieldNameIndex("GEOID");
-                auto countyId = countyIt->attribute(countyIDidx).toString();
+                auto countyIDidx = county.fieldNameIndex("GEOID");
+                auto countyId = county.attribute(countyIDidx).toString();
 
                 res.insert(countyId);
 
                 found = true;
                 break;
             }
-
-            countyIt++;
-        }
-
-        // Try to find it in the full county vector
-        if(!found)
-        {
-            auto countyIt = countyFeatVec.constBegin();
-            while(countyIt != countyFeatVec.constEnd())
-            {
-                auto countyGeom = countyIt->geometry();
-
-                if(testInPolygon(countyGeom,buildCentroid,polygonGeometryEngine.get()) == true)
-                {
-
-                    auto countyIDidx = countyIt->fieldNameIndex("GEOID");
-                    auto countyId = countyIt->attribute(countyIDidx).toString();
-
-                    res.insert(countyId);
-
-                    found = true;
-                    break;
-                }
-
-                countyIt++;
-            }
         }
 
         // If still not found then error
@@ -818,6 +775,11 @@ int HousingUnitAllocationWidget::linkBuildingsAndParcels(void)
     auto countFound = 0;
     auto countNotFound = 0;
 
+    // Index the parcel bounding boxes so that each building only queries the parcels near it
+    SpatialBoxIndex parcelIndex;
+    for(auto it = parcelsMap.constBegin(); it != parcelsMap.constEnd(); ++it)
+        parcelIndex.insert(it.key(), it.value()->parcelFeat.geometry().boundingBox());
+
     //    QMapIterator<QgsFeatureId,std::shared_ptr<Building>> buildingIt(buildingsMap);
     //    while (buildingIt.hasNext())
 
@@ -844,25 +806,18 @@ int HousingUnitAllocationWidget::linkBuildingsAndParcels(void)
 
         bool found = false;
 
-        for(auto&& parcel : parcelsMap)
-        {
-            auto parcelGeom = parcel->parcelFeat.geometry();
+        // The parcel with the lowest id whose bounding box contains the building centroid
+        auto parcelId = parcelIndex.firstContaining(buildCentroidXY);
 
-            // Do initial bounding box check which is very fast to exclude points that are far away
-            auto bb = parcelGeom.boundingBox();
+        if(!FID_IS_NULL(parcelId))
+        {
+            auto parcel = parcelsMap.value(parcelId);
 
-            if(bb.contains(buildCentroidXY))
-            {
-                //                if(polygonGeometryEngine->intersects(parcelGeom.constGet()))
-                //                {
-                // Associate the parcel with the building and vice versa
-                parcel->associatedBuildings.push_back(buildObj);
-                buildObj->associatedParcel = parcel;
-                found = true;
-                ++countFound;
-                break;
-                //                }
-            }
+            // Associate the parcel with the building and vice versa
+            parcel->associatedBuildings.push_back(buildObj);
+            buildObj->associatedParcel = parcel;
+            found = true;
+            ++countFound;
         }
 
         if(!found)
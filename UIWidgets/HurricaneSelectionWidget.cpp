@@ -43,10 +43,10 @@ UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 #include "HurricaneParameterWidget.h"
 #include "SimCenterPreferences.h"
 #include "SiteConfig.h"
-#include "GridNode.h"
 #include "NodeHandle.h"
 #include "LayerTreeItem.h"
 #include "CSVReaderWriter.h"
+#include "EventGridFile.h"
 #include "Utils/ProgramOutputDialog.h"
 
 //Test
@@ -99,13 +99,20 @@ HurricaneSelectionWidget::HurricaneSelectionWidget(VisualizationWidget* visWidge
     trackLineEdit = nullptr;
     typeOfScenarioWidget = nullptr;
     runButton = nullptr;
+    cancelButton = nullptr;
     divLatSpinBox = nullptr;
     divLonSpinBox = nullptr;
 
-    process = new QProcess(this);
-    connect(process, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished), this, &HurricaneSelectionWidget::handleProcessFinished);
-    connect(process, &QProcess::readyReadStandardOutput, this, &HurricaneSelectionWidget::handleProcessTextOutput);
-    connect(process, &QProcess::started, this, &HurricaneSelectionWidget::handleProcessStarted);
+    // The hazard simulation runs in the background, its output is streamed to the status window
+    hazardRunner = new ProcessRunner(this);
+    connect(hazardRunner, &ProcessRunner::finished, this, &HurricaneSelectionWidget::handleProcessFinished);
+    connect(hazardRunner, &ProcessRunner::outputLine, this, &HurricaneSelectionWidget::handleProcessTextOutput);
+    connect(hazardRunner, &ProcessRunner::errorLine, this, &HurricaneSelectionWidget::handleProcessTextOutput);
+    connect(hazardRunner, &ProcessRunner::progress, this, &HurricaneSelectionWidget::handleProcessProgress);
+    connect(hazardRunner, &ProcessRunner::failedToStart, this, [this](const QString& err){
+        this->errorMessage("Could not start the hazard simulation: " + err);
+    });
+    connect(hazardRunner, &ProcessRunner::started, this, &HurricaneSelectionWidget::handleProcessStarted);
 
     eventDatabaseFile = "";
 
@@ -473,8 +480,13 @@ QStackedWidget* HurricaneSelectionWidget::getHurricaneSelectionWidget(void)
     runButton = new QPushButton(tr("&Run"));
     connect(runButton,&QPushButton::clicked,this,&HurricaneSelectionWidget::runHazardSimulation);
 
+    cancelButton = new QPushButton(tr("&Cancel"));
+    cancelButton->setEnabled(false);
+    connect(cancelButton,&QPushButton::clicked,this,&HurricaneSelectionWidget::cancelHazardSimulation);
+
     bottomLayout->addWidget(runLabel);
     bottomLayout->addWidget(runButton);
+    bottomLayout->addWidget(cancelButton);
 
 
     mainLayout->addLayout(topLayout, 0,0);
@@ -604,6 +616,8 @@ void HurricaneSelectionWidget::loadHurricaneButtonClicked(void)
 
 void HurricaneSelectionWidget::clear(void)
 {
+    this->cancelHazardSimulation();
+
     eventDatabaseFile.clear();
 
     selectedHurricaneName->setText("None");
@@ -650,6 +664,12 @@ void HurricaneSelectionWidget::showPointOnMap(void)
 
 void HurricaneSelectionWidget::runHazardSimulation(void)
 {
+    // Checked before anything is written, the input files of the running simulation must not be overwritten
+    if(hazardRunner->isRunning())
+    {
+        this->errorMessage("A hazard simulation is already running, wait for it to finish or cancel it first");
+        return;
+    }
 
     QString workingDir = SimCenterPreferences::getInstance()->getLocalWorkDir();
 
@@ -893,16 +913,33 @@ void HurricaneSelectionWidget::runHazardSimulation(void)
 
     qDebug()<<"Hazard Simulation Command:"<<args[0]<<" "<<args[1]<<" "<<args[2];
 
-    process->start(pythonPath, args);
-    process->waitForStarted();
+    hazardRunner->start(pythonPath, args);
+}
+
+
+void HurricaneSelectionWidget::cancelHazardSimulation(void)
+{
+    if(!hazardRunner->isRunning())
+        return;
+
+    this->statusMessage("Cancelling the hazard simulation");
+
+    hazardRunner->cancel();
 }
 
 
 void HurricaneSelectionWidget::handleProcessFinished(int exitCode, QProcess::ExitStatus exitStatus)
 {
     this->runButton->setEnabled(true);
+    this->cancelButton->setEnabled(false);
     this->getProgressDialog()->hideProgressBar();
 
+    if(hazardRunner->wasCancelled())
+    {
+        this->statusMessage("The hazard simulation was cancelled");
+        return;
+    }
+
     if(exitStatus == QProcess::ExitStatus::CrashExit)
     {
         QString errText("Error, the process running the hazard simulation script crashed");
@@ -937,16 +974,21 @@ void HurricaneSelectionWidget::handleProcessStarted(void)
 {
     this->statusMessage("Running script in the background");
     this->runButton->setEnabled(false);
+    this->cancelButton->setEnabled(true);
 
     this->getProgressDialog()->showProgressBar();
 }
 
 
-void HurricaneSelectionWidget::handleProcessTextOutput(void)
+void HurricaneSelectionWidget::handleProcessTextOutput(const QString& line)
 {
-    QByteArray output = process->readAllStandardOutput();
+    this->statusMessage(line);
+}
+
 
-    this->statusMessage(QString(output));
+void HurricaneSelectionWidget::handleProcessProgress(const double percent, const QString& message)
+{
+    this->statusMessage("Hazard simulation " + QString::number(percent) + "% complete " + message);
 }
 
 
@@ -983,59 +1025,44 @@ int HurricaneSelectionWidget::loadResults(const QString& outputDir)
         return -1;
     }
 
-    CSVReaderWriter csvTool;
+    EventGridFile gridFile;
 
     QString err;
-    QVector<QStringList> data = csvTool.parseCSVFile(resultsPath,err);
+    QStringList IMNames;
+    QVector<EventGridSite> sites;
 
-    if(!err.isEmpty())
+    auto numSites = gridFile.read(resultsPath, IMNames, sites, err);
+
+    if(numSites < 0)
     {
         this->errorMessage(err);
         return -1;
     }
 
-    if(data.empty())
+    if(numSites == 0)
         return -1;
 
-    auto headerFields = data.front();
+    auto idxPWS = IMNames.indexOf("PWS");
 
-    auto stationIndex = headerFields.indexOf("GP_file");
-    auto latIndex = headerFields.indexOf("Latitude");
-    auto lonIndex = headerFields.indexOf("Longitude");
-
-    if(stationIndex == -1 || latIndex == -1 || lonIndex == -1)
+    if(idxPWS == -1)
     {
-        this->errorMessage("Could not find the requires indexes for station name, lat, and lon");
+        this->errorMessage("Error, PWS index not found in headers");
         return -1;
     }
 
-    // Pop off the row that contains the header information
-    data.pop_front();
-
-    auto numRows = data.size();
-
     QgsFeatureList featList;
-    featList.reserve(numRows);
+    featList.reserve(numSites);
     // Get the data
-    for(int i = 0; i<numRows; ++i)
+    for(auto&& site : sites)
     {
-
-        auto vecValues = data.at(i);
-
-        if(vecValues.size() != 3)
-        {
-            this->errorMessage("Error in importing wind field");
-            return -1;
-        }
-
-        auto stationName = vecValues[stationIndex].remove(".csv");
+        auto stationName = site.name;
 
         auto stationPath = outputDir + QDir::separator() + stationName + ".csv";
 
         // Find the station in the map
         auto station = stationMap.find(stationName);
 
-        if(station->isNull())
+        if(station == stationMap.end() || station->isNull())
         {
             this->errorMessage("Error, could not find the station in the map");
             return -1;
@@ -1043,39 +1070,17 @@ int HurricaneSelectionWidget::loadResults(const QString& outputDir)
 
         station->setStationFilePath(stationPath);
 
-        try {
-            station->importWindFieldStation();
-        } catch (const QString& err) {
-            this->errorMessage(err);
-            return -1;
-        }
-
-        auto pws = station->getStationData();
-
-        if(pws.empty())
+        if(site.realizations.empty())
         {
             this->errorMessage("Error getting the peak wind speeds from the results");
             return -1;
         }
 
-        auto headings =  station->getStationDataHeaders();
-
-        auto idxPWS = headings.indexOf("PWS");
-
-        if(idxPWS == -1)
-        {
-            this->errorMessage("Error, PWS index not found in headers");
-            return -1;
-        }
-
-        QString pwsStr;
-
-        for(int i = 0; i<pws.size()-1; ++i)
-        {
-            pwsStr += pws[i].at(idxPWS) + ", ";
-        }
+        QStringList pwsList;
+        for(auto&& realization : site.realizations)
+            pwsList.append(QString::number(realization.at(idxPWS)));
 
-        pwsStr += pws.back().at(idxPWS);
+        auto pwsStr = pwsList.join(", ");
 
         QString attribute = "Peak Wind Speeds";
 
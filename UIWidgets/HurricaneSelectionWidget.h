@@ -44,6 +44,8 @@ UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 
 #include <memory>
 
+#include "ProcessRunner.h"
+
 #include <QProcess>
 #include <QMap>
 
@@ -101,8 +103,14 @@ public slots:
     // Brings up the dialog and tells the user that the process has started
     void handleProcessStarted(void);
 
-    // Displays the text output of the process in the dialog
-    void handleProcessTextOutput(void);
+    // Displays the text output of the process in the dialog, one line at a time
+    void handleProcessTextOutput(const QString& line);
+
+    // Displays the progress reported by the process
+    void handleProcessProgress(const double percent, const QString& message);
+
+    // Stops the hazard simulation if it is running
+    void cancelHazardSimulation(void);
 
 protected slots:
 
@@ -173,8 +181,9 @@ protected:
 
     QMap<QString,WindFieldStation> stationMap;
 
-    QProcess* process;
+    ProcessRunner* hazardRunner;
     QPushButton* runButton;
+    QPushButton* cancelButton;
 
     VisualizationWidget* theVizWidget;
 };
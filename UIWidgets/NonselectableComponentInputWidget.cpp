@@ -41,6 +41,7 @@ UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 #include "NonselectableComponentInputWidget.h"
 #include "VisualizationWidget.h"
 #include "CSVReaderWriter.h"
+#include "ColumnarTable.h"
 #include "ComponentTableView.h"
 #include "ComponentTableModel.h"
 
@@ -143,7 +144,7 @@ bool NonselectableComponentInputWidget::loadComponentData(void)
     CSVReaderWriter csvTool;
     
     QString err;
-    QVector<QStringList> data = csvTool.parseCSVFile(pathToComponentInputFile,err);
+    ColumnarTable data = csvTool.parseCSVFileToTable(pathToComponentInputFile,err);
     
     if(!err.isEmpty())
     {
@@ -151,14 +152,14 @@ bool NonselectableComponentInputWidget::loadComponentData(void)
         return false;
     }
     
-    if(data.empty())
+    if(data.columnCount() == 0)
     {
         this->errorMessage("Input file is empty");
         return false;
     }
     
     // Get the header file
-    QStringList tableHeadings = data.first();
+    QStringList tableHeadings = data.getHeader();
     
     tableHorizontalHeadings = tableHeadings;
     
@@ -166,10 +167,7 @@ bool NonselectableComponentInputWidget::loadComponentData(void)
     
     emit headingValuesChanged(tableHeadings);
     
-    // Pop off the row that contains the header information
-    data.pop_front();
-    
-    auto numRows = data.size();
+    auto numRows = data.rowCount();
     
     if(numRows == 0)
     {
@@ -181,15 +179,13 @@ bool NonselectableComponentInputWidget::loadComponentData(void)
         QApplication::processEvents();
     }
     
-    auto firstRow = data.first();
-    
-    if(firstRow.empty())
+    if(data.isRowNull(0))
     {
         this->errorMessage("First row is empty");
         return false;
     }
     
-    componentTableWidget->getTableModel()->populateData(data, tableHorizontalHeadings);
+    componentTableWidget->getTableModel()->populateData(std::move(data));
     
     label2->show();
     componentTableWidget->show();
@@ -490,11 +486,7 @@ bool NonselectableComponentInputWidget::copyFiles(QString &destName)
     if(nRows == 0)
         return false;
 
-    auto data = componentTableWidget->getTableModel()->getTableData();
-
-    auto headerValues = componentTableWidget->getTableModel()->getHeaderStringList();
-
-    data.push_front(headerValues);
+    const auto& data = componentTableWidget->getTableModel()->getTable();
 
     CSVReaderWriter csvTool;
 
@@ -560,7 +552,11 @@ void NonselectableComponentInputWidget::handleCellChanged(const int row, const i
 
     auto attribVal = componentTableWidget->item(row,col);
 
-    theComponentDb->updateComponentAttribute(ID,attrib,attribVal);
+    QString err;
+    auto res = theComponentDb->updateComponentAttributes({{ID,attrib,attribVal}}, err);
+
+    if(res == false)
+        this->errorMessage("Error could not update asset "+QString::number(ID)+" after cell change: "+err);
 }
 
 
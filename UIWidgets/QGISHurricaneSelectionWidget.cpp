@@ -38,12 +38,13 @@ UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 
 #include "QGISHurricaneSelectionWidget.h"
 #include "QGISVisualizationWidget.h"
+#include "ScreenToGeoTransform.h"
 #include "SimCenterMapcanvasWidget.h"
 #include "HurricaneParameterWidget.h"
 
 #include "NodeHandle.h"
-#include "GridNode.h"
 #include "RectangleGrid.h"
+#include "EventGridFile.h"
 
 #include <QPushButton>
 #include <QJsonArray>
@@ -280,14 +281,23 @@ void QGISHurricaneSelectionWidget::handleGridSelected(void)
     if(!userGrid->isVisible())
         return;
 
-    // Get the vector of grid nodes
-    auto gridNodeVec = userGrid->getGridNodeVec();
+    // Get the grid node locations
+    auto gridPoints = userGrid->getGridPoints();
 
-    if(gridNodeVec.isEmpty())
+    if(gridPoints.isEmpty())
         return;
 
     auto mapCanvas = mapViewSubWidget->mapCanvas();
 
+    // The latitude and longitude of all of the nodes
+    QString transformErr;
+    auto geoPoints = ScreenToGeoTransform::toGeographic(mapCanvas, gridPoints, transformErr);
+    if(!transformErr.isEmpty())
+    {
+        this->errorMessage(transformErr);
+        return;
+    }
+
     // Create the fields
     QgsFields featFields;
     featFields.append(QgsField("AssetType", QVariant::String));
@@ -303,21 +313,17 @@ void QGISHurricaneSelectionWidget::handleGridSelected(void)
 
     QgsFeatureList featureList;
 
-    QStringList headerRow = {"GP_file", "Latitude", "Longitude"};
+    QStringList headerRow = EventGridFile::legacyGridHeader();
     gridData.push_back(headerRow);
 
-    for(int i = 0; i<gridNodeVec.size(); ++i)
+    for(int i = 0; i<gridPoints.size(); ++i)
     {
-        auto gridNode = gridNodeVec.at(i);
 
         // The station id
         auto stationName = QString::number(i+1);
 
-        auto screenPoint = gridNode->getPoint();
-
-        // The latitude and longitude
-        auto longitude = theVisualizationWidget->getLongFromScreenPoint(screenPoint,mapCanvas);
-        auto latitude = theVisualizationWidget->getLatFromScreenPoint(screenPoint,mapCanvas);
+        auto latitude = geoPoints.at(i).y();
+        auto longitude = geoPoints.at(i).x();
 
         WindFieldStation station(stationName,latitude,longitude);
 
@@ -398,7 +404,7 @@ void QGISHurricaneSelectionWidget::handleLandfallPointSelected(void)
         this->clearLandfallFromMap();
     }
 
-    // Get the vector of grid nodes
+    // Get the grid node locations
     auto posNodeVec = userPoint->pos();
 
     if(posNodeVec.isNull())
@@ -36,7 +36,9 @@ UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 
 // Written by: Stevan Gavrilovic
 
-#include "CSVReaderWriter.h"
+#include "EventGridFile.h"
+#include "EventGridHdf5File.h"
+#include "RasterBlockSampler.h"
 #include "LayerTreeView.h"
 #include "RasterHazardInputWidget.h"
 #include "VisualizationWidget.h"
@@ -75,11 +77,6 @@ UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 #include <qgscollapsiblegroupbox.h>
 #include <qgsproject.h>
 
-// Test to remove start
-#include <chrono>
-using namespace std::chrono;
-// Test to remove end
-
 
 RasterHazardInputWidget::RasterHazardInputWidget(VisualizationWidget* visWidget, QWidget *parent) : SimCenterAppWidget(parent)
 {
@@ -150,6 +147,20 @@ bool RasterHazardInputWidget::inputFromJSON(QJsonObject &jsonObject)
     if (jsonObject.contains("eventFile"))
         eventFile = jsonObject["eventFile"].toString();
 
+    // An event file with an HDF5 extension is written as a single HDF5 dataset instead of a csv file
+    auto eventFileSuffix = QFileInfo(eventFile).suffix().toLower();
+    asHdf5 = (eventFileSuffix == "h5" || eventFileSuffix == "hdf5");
+
+    // Without HDF5 in this build the option is turned off and the event grid is written as a csv file instead
+    if(asHdf5 && !EventGridHdf5File::isAvailable())
+    {
+        auto csvEventFile = QFileInfo(eventFile).completeBaseName() + ".csv";
+        this->infoMessage("Warning, the event file "+eventFile+" requires HDF5 support, which is not included in this build. Writing the event grid to "+csvEventFile+" instead");
+
+        eventFile = csvEventFile;
+        asHdf5 = false;
+    }
+
     bool res = theIMs->inputFromJSON(jsonObject);
     if (res == false) 
       errorMessage("RasterHazard::input of intensity measures failed" );
@@ -425,22 +436,6 @@ int RasterHazardInputWidget::loadRaster(void)
 
     theVisualizationWidget->zoomToLayer(rasterlayer);
 
-    //    // Test to remove start
-    //    auto start = high_resolution_clock::now();
-    //    // Test to remove end
-
-    //    for(int i = 0; i<1000000; ++i)
-    //    {
-    //        auto rnd = static_cast<double>(std::rand()/((RAND_MAX + 1u)/0.1));
-    //        this->sampleRaster(-94.87183+rnd,29.24216+rnd,1);
-    //    }
-
-    //    // Test to remove start
-    //    auto stop = high_resolution_clock::now();
-    //    auto duration = duration_cast<milliseconds>(stop - start);
-    //    this->statusMessage("Duration: "+QString::number(duration.count()));
-    //    // Test to remove end
-
     return 0;
 }
 
@@ -490,7 +485,7 @@ bool RasterHazardInputWidget::copyFiles(QString &destDir)
     }
 
 
-    QVector<QStringList> pointDataVector;
+    QVector<QgsPointXY> points;
 
     // Iterate through the asset databases
     for(auto&& theAssetDB :  theAssetDBs)
@@ -503,7 +498,7 @@ bool RasterHazardInputWidget::copyFiles(QString &destDir)
 
         auto numPoints = theAssetDB->getSelectedLayer()->featureCount();
 
-        pointDataVector.reserve(pointDataVector.size() + numPoints);
+        points.reserve(points.size() + numPoints);
 
         QgsFeatureIterator fit = theAssetDB->getSelectedLayer()->getFeatures();
 
@@ -545,79 +540,89 @@ bool RasterHazardInputWidget::copyFiles(QString &destDir)
                 y = centroid.y();
             }
 
-            auto xstr = QString::number(x,'g', 10);
-            auto ystr = QString::number(y,'g', 10);
-
-            QStringList pointData;
-            pointData.append(xstr);
-            pointData.append(ystr);
-
-            for(int i = 0; i< selectedIMs.size(); ++i)
-            {
-                auto val = this->sampleRaster(x, y, i+1);
-                auto valStr = QString::number(val);
-
-                pointData.append(valStr);
-            }
-
-            pointDataVector.push_back(pointData);
+            points.append(QgsPointXY(x,y));
         }
     }
 
-    // Save the hazards as a bunch of csv files
-    if(!asHdf5)
-    {
-        CSVReaderWriter csvTool;
+    // Sample all of the bands at all of the assets in one pass over the raster tiles
+    QList<int> bands;
+    for(int i = 0; i< selectedIMs.size(); ++i)
+        bands.append(i+1);
 
-        // First create the event grid file
-        QVector<QStringList> gridData;
+    RasterBlockSampler sampler(dataProvider);
+    sampler.setOutOfBoundsValue(0.0);
+    sampler.setNoDataValue(0.0);
 
-        QStringList headerRow = {"GP_file", "Latitude", "Longitude"};
-        gridData.push_back(headerRow);
+    QVector<double> sampledValues;
+    QString sampleErr;
+    if(sampler.sample(points, bands, sampledValues, sampleErr) != 0)
+    {
+        this->errorMessage(sampleErr);
+        return false;
+    }
 
-        // QStringList stationHeader = bandNames;
+    // Same as sampling one point at a time, where both cases failed to sample and were set to zero
+    if(sampler.getNumOutOfBounds() > 0 || sampler.getNumNoData() > 0)
+        this->infoMessage("Warning, error sampling the raster at "+QString::number(sampler.getNumOutOfBounds() + sampler.getNumNoData())+" assets, "+QString::number(sampler.getNumOutOfBounds())+" may be out of bounds and "+QString::number(sampler.getNumNoData())+" are on cells without data. Setting their raster values to zero");
 
+    // Save the hazards as an event grid in the legacy layout, a grid file and one site file per site, which is what the backend reads
+    if(!asHdf5)
+    {
         QApplication::processEvents();
 
-        for(int i = 0; i<pointDataVector.size(); ++i)
-        {
-            auto stationFile = "Site_"+QString::number(i)+".csv";
+        EventGridFile gridFile;
 
-            auto point = pointDataVector.at(i);
-
-            auto lon = point.at(0);
-            auto lat = point.at(1);
+        QString err;
+        if(gridFile.open(pathToEventFile, selectedIMs, err) != 0)
+        {
+            this->errorMessage(err);
+            return false;
+        }
 
-            // Get the grid row
-            QStringList gridRow = {stationFile, lat, lon};
-            gridData.push_back(gridRow);
+        const auto numBands = bands.size();
 
-            QStringList stationRow = {point.begin()+2,point.end()};
+        for(int i = 0; i<points.size(); ++i)
+        {
+            // Keep the 10 significant digits that the site locations were always written with
+            auto lon = QString::number(points.at(i).x(),'g', 10).toDouble();
+            auto lat = QString::number(points.at(i).y(),'g', 10).toDouble();
 
-            // Save the station data
-            QVector<QStringList> stationData = {selectedIMs};
-						
+            QStringList stationRow;
+            stationRow.reserve(numBands);
+            for(int j = 0; j<numBands; ++j)
+                stationRow.append(QString::number(sampledValues.at(i*numBands + j)));
 
-            stationData.push_back(stationRow);
+            gridFile.addSite(lat, lon, stationRow);
+        }
 
-            QString pathToStationFile = destDir + QDir::separator() + stationFile;
+        if(gridFile.close(err) != 0)
+        {
+            this->errorMessage(err);
+            return false;
+        }
+    }
+    else
+    {
+        QApplication::processEvents();
 
-            QString err;
-            auto res2 = csvTool.saveCSVFile(stationData, pathToStationFile, err);
-            if(res2 != 0)
-            {
-                this->errorMessage(err);
-                return false;
-            }
+        // The raster gives a single event with one band per intensity measure, so the sampled values are already in the events x sites x IMs order
+        QVector<double> latitudes;
+        QVector<double> longitudes;
+        latitudes.reserve(points.size());
+        longitudes.reserve(points.size());
 
+        for(auto&& point : points)
+        {
+            latitudes.append(point.y());
+            longitudes.append(point.x());
         }
 
-        // Now save the site grid .csv file
-        QString err2;
-        auto res2 = csvTool.saveCSVFile(gridData, pathToEventFile, err2);
-        if(res2 != 0)
+        EventGridHdf5File gridFile;
+
+        QString err;
+        if(gridFile.write(pathToEventFile, selectedIMs, latitudes, longitudes, sampledValues, 1, err) != 0)
         {
-            this->errorMessage(err2);
+            this->errorMessage(err);
             return false;
         }
     }
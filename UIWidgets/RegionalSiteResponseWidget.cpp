@@ -51,11 +51,11 @@ UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 #include "Vs30Widget.h"
 #include "BedrockDepthWidget.h"
 #include "SoilModelWidget.h"
-#include "GridNode.h"
 #include "SimCenterPreferences.h"
 #include "QGISSiteInputWidget.h"
 
 #include "QGISVisualizationWidget.h"
+#include "ScreenToGeoTransform.h"
 
 #include <qgsvectorlayer.h>
 #include "SimCenterMapcanvasWidget.h"
@@ -1340,19 +1340,25 @@ void RegionalSiteResponseWidget::getSiteData(void)
             this->statusMessage(msg);
             return;
         }
-        // Get the vector of grid nodes
-        auto gridNodeVec = userGrid->getGridNodeVec();
+        // Get the grid node locations
+        auto gridPoints = userGrid->getGridPoints();
         auto mapCanvas = mapViewSubWidget->getMapCanvasWidget()->mapCanvas();
-        for(int i = 0; i<gridNodeVec.size(); ++i)
+        // The latitude and longitude of all of the nodes
+        QString transformErr;
+        auto geoPoints = ScreenToGeoTransform::toGeographic(mapCanvas, gridPoints, transformErr);
+        if(!transformErr.isEmpty())
+        {
+            this->errorMessage(transformErr);
+            return;
+        }
+
+        for(int i = 0; i<gridPoints.size(); ++i)
         {
-            auto gridNode = gridNodeVec.at(i);
             QStringList stationRow;
             // The station id
             stationRow.push_back(QString::number(i));
-            auto screenPoint = gridNode->getPoint();
-            // The latitude and longitude
-            auto longitude = theVisualizationWidget->getLongFromScreenPoint(screenPoint,mapCanvas);
-            auto latitude = theVisualizationWidget->getLatFromScreenPoint(screenPoint,mapCanvas);
+            auto latitude = geoPoints.at(i).y();
+            auto longitude = geoPoints.at(i).x();
             stationRow.push_back(QString::number(latitude));
             stationRow.push_back(QString::number(longitude));
             gridData.push_back(stationRow);
@@ -41,6 +41,7 @@ UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 #include "GeneralInformationWidget.h"
 #include "PelicunPostProcessor.h"
 #include "CBCitiesPostProcessor.h"
+#include "GeoJSONFeatureSplitter.h"
 #include "ResultsWidget.h"
 #include "SimCenterPreferences.h"
 #include <WorkflowAppR2D.h>
@@ -71,6 +72,7 @@ UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 #include <qgsvectorlayer.h>
 #include <qgsfillsymbol.h>
 #include <qgsmarkersymbol.h>
+#include <qgsvirtuallayerdefinition.h>
 ResultsWidget::ResultsWidget(QWidget *parent, VisualizationWidget* visWidget) : SimCenterAppWidget(parent)
 {
     theVisualizationWidget = static_cast<QGISVisualizationWidget*>(visWidget);
@@ -262,67 +264,48 @@ int ResultsWidget::processResults(QString resultsDirectory)
 
     QString pathGeojson = resultsDirectory + QDir::separator() +  QString("R2D_results.geojson");
     QFile jsonFile(pathGeojson);
-    QMap<QString, QList<QJsonObject>> assetDictionary;
     QMap<QString, QList<QString>> assetTypeToType;
-    QJsonObject crs;
-    if (jsonFile.exists() && jsonFile.open(QFile::ReadOnly)) {
 
-        QJsonDocument exDoc = QJsonDocument::fromJson(jsonFile.readAll());
-        QJsonObject jsonObject = exDoc.object();
+    // Stream the features of the results into one <type>.geojson file per asset type without loading the whole file
+    GeoJSONFeatureSplitter resultsSplitter;
+    if (jsonFile.exists()) {
 
-        if(jsonObject.contains("crs"))
-            crs = jsonObject["crs"].toObject();
-        QString crsString = crs["properties"].toObject()["name"].toString();
-        QgsCoordinateReferenceSystem qgsCRS = QgsCoordinateReferenceSystem(crsString);
-        if (!qgsCRS.isValid()){
-            qgsCRS.createFromOgcWmsCrs(crsString);
-        }
-        if (!qgsCRS.isValid()){
-            QString msg = "The CRS defined in " + pathGeojson + "is invalid and ignored";
-            errorMessage(msg);
-        }
-        QJsonArray features = jsonObject["features"].toArray();
-        for (const QJsonValue& valueIt : features) {
-            QJsonObject value = valueIt.toObject();
-            // Get the type
-            QJsonObject assetProperties = value["properties"].toObject();
-            if (!jsonObject.contains("type")) {
-                this->errorMessage("The Json object is missing the 'type' key that defines the asset type");
-                return false;
-            }
+        auto routeFeature = [&assetTypeToType](const QJsonObject& assetProperties) -> QString
+        {
             // type is Bridge/Tunnel/Road
             QString type = assetProperties["type"].toString();
             if (type.compare("")==0){
                 type = "Building";
             }
-            if (!assetDictionary.contains(type))
-            {
-                assetDictionary[type] = QList<QJsonObject>({value});
-            }
-            else
-            {
-                QList<QJsonObject>& featList = assetDictionary[type];
-                featList.append(value);
-            }
             // assetType is Transportation Network
             QString assetType = assetProperties["assetType"].toString();
-            if (!assetTypeToType.contains(assetType))
-            {
-                assetTypeToType[assetType] = QList<QString>({type});
-            }
-            else
-            {
-                QList<QString>& typesList = assetTypeToType[assetType];
-                bool typeExists = false;
-                for (QString it : typesList){
-                    if (it.compare(type)==0){
-                        typeExists = true;
-                    }
-                }
-                if (!typeExists){
-                    typesList.append(type);
-                }
+            QList<QString>& typesList = assetTypeToType[assetType];
+            if (!typesList.contains(type)){
+                typesList.append(type);
             }
+            return type;
+        };
+
+        QString err;
+        if (resultsSplitter.split(pathGeojson, resultsDirectory, routeFeature, err) != 0) {
+            this->errorMessage(err);
+            return false;
+        }
+
+        if (!resultsSplitter.getGroupNames().isEmpty() && !resultsSplitter.getTopLevelMembers().contains("type")) {
+            this->errorMessage("The Json object is missing the 'type' key that defines the asset type");
+            return false;
+        }
+
+        QJsonObject crs = resultsSplitter.getCrs();
+        QString crsString = crs["properties"].toObject()["name"].toString();
+        QgsCoordinateReferenceSystem qgsCRS = QgsCoordinateReferenceSystem(crsString);
+        if (!qgsCRS.isValid()){
+            qgsCRS.createFromOgcWmsCrs(crsString);
+        }
+        if (!qgsCRS.isValid()){
+            QString msg = "The CRS defined in " + pathGeojson + "is invalid and ignored";
+            errorMessage(msg);
         }
     }
     else{
@@ -334,36 +317,9 @@ int ResultsWidget::processResults(QString resultsDirectory)
     if (jsonFile.exists()){
     QVector<QgsMapLayer*> mapLayers;
     QVector<QgsMapLayer*> DMGLayers;
-    for (auto it = assetDictionary.begin(); it != assetDictionary.end(); ++it)
+    for (auto&& assetType : resultsSplitter.getGroupNames())
     {
-        QString assetType = it.key();
-        QList<QJsonObject> features = it.value();
-
-        QJsonArray featuresArray;
-        for (const auto& obj : features) {
-            featuresArray.append(obj);
-        }
-
-        QJsonObject assetDictionary;
-        assetDictionary["type"]="FeatureCollection";
-        assetDictionary["features"]=featuresArray;
-
-        if(!crs.isEmpty())
-            assetDictionary["crs"]=crs;
-
-        QString outputFile = resultsDirectory + QDir::separator() + assetType + ".geojson";
-
-        QFile file(outputFile);
-        if (!file.open(QFile::WriteOnly | QFile::Text))
-        {
-            this->errorMessage("Error creating the asset output json file in GeojsonAssetInputWidget");
-            return false;
-        }
-
-        // Write the file to the folder
-        QJsonDocument doc(assetDictionary);
-        file.write(doc.toJson());
-        file.close();
+        QString outputFile = resultsSplitter.getGroupFilePath(assetType);
 
         QgsVectorLayer* assetLayer;
         assetLayer = theVisualizationWidget->addVectorLayer(outputFile, assetType + QString("_results"), "ogr");
@@ -372,9 +328,14 @@ int ResultsWidget::processResults(QString resultsDirectory)
             this->errorMessage("Error, failed to add GIS layer");
             return false;
         }
+        // The damage state view shares the features of the results layer
         QgsVectorLayer* DMGlayer;
-        DMGlayer = theVisualizationWidget->duplicateExistingLayer(assetLayer);
-        DMGlayer->setName(assetType + QString("_DMG"));
+        DMGlayer = this->addSharedLayerView(assetLayer, assetType + QString("_DMG"));
+        if(DMGlayer == nullptr)
+        {
+            this->errorMessage("Error, failed to add the damage state GIS layer");
+            return false;
+        }
         QgsSymbol* markerSymbol = nullptr;
         // Get the layer type
         QString layerType;
@@ -464,6 +425,29 @@ int ResultsWidget::processResults(QString resultsDirectory)
 }
 
 
+QgsVectorLayer* ResultsWidget::addSharedLayerView(QgsVectorLayer* layer, const QString& name)
+{
+    // A virtual layer that only references another layer, without a query, passes the features of that layer through
+    QgsVirtualLayerDefinition layerDefinition;
+    layerDefinition.addSource(layer->name(), layer->id());
+
+    auto sharedLayer = theVisualizationWidget->addVectorLayer(layerDefinition.toString(), name, "virtual");
+
+    if(sharedLayer != nullptr && sharedLayer->isValid())
+        return sharedLayer;
+
+    if(sharedLayer != nullptr)
+        theVisualizationWidget->removeLayer(sharedLayer);
+
+    auto duplicateLayer = theVisualizationWidget->duplicateExistingLayer(layer);
+
+    if(duplicateLayer != nullptr)
+        duplicateLayer->setName(name);
+
+    return duplicateLayer;
+}
+
+
 int ResultsWidget::printToPDF(void)
 {
     auto outputFileName = exportPathLineEdit->text();
@@ -55,6 +55,8 @@ class QLabel;
 class QLineEdit;
 class QPushButton;
 
+class QgsVectorLayer;
+
 class ResultsWidget : public SimCenterAppWidget
 {
 
@@ -82,6 +84,9 @@ private slots:
 
 private:
 
+    // Adds a layer that shares the features of the given layer so it can be drawn with another renderer; falls back to a duplicate layer
+    QgsVectorLayer* addSharedLayerView(QgsVectorLayer* layer, const QString& name);
+
     QStackedWidget* mainStackedWidget = nullptr;
     QTabWidget* resTabWidget = nullptr;
     QLabel* resultsMainLabel = nullptr;
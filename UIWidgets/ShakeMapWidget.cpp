@@ -40,7 +40,7 @@ UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 #include "VisualizationWidget.h"
 #include "CustomListWidget.h"
 #include "XMLAdaptor.h"
-#include "CSVReaderWriter.h"
+#include "EventGridFile.h"
 #include "TreeItem.h"
 #include "Utils/FileOperations.h"
 
@@ -391,7 +391,7 @@ int ShakeMapWidget::loadDataFromDirectory(const QString& dir)
 
             XMLlayer->setName("Grid");
 
-            inputShakeMap->stationList = XMLImportAdaptor.getStationList();
+            inputShakeMap->gridData = XMLImportAdaptor.getGridData();
 
             inputShakeMap->gridLayer = XMLlayer;
             layerGroup.push_back(XMLlayer);
@@ -832,23 +832,21 @@ bool ShakeMapWidget::copyFiles(QString &destDir)
         return false;
     }
 
-    CSVReaderWriter csvTool;
+    const auto& gridData = selectedShakeMap->gridData;
 
-    auto stationList = selectedShakeMap->stationList;
+    auto numPoints = gridData.numPoints();
 
-    if(stationList.empty())
+    if(numPoints == 0)
     {
         this->errorMessage("Error, the station list is empty for "+currItemName);
         return false;
     }
 
-    // First create the event grid file
-    QVector<QStringList> gridData;
+    QStringList stationHeader;
 
-    QStringList headerRow = {"GP_file", "Latitude", "Longitude"};
-    gridData.push_back(headerRow);
+    // The column of each selected IM in the grid data
+    QVector<int> IMIndexes;
 
-    QStringList stationHeader;
     for(int i = 0; i < IMListWidget->count(); ++i)
     {
         auto item = IMListWidget->item(i);
@@ -858,112 +856,62 @@ bool ShakeMapWidget::copyFiles(QString &destDir)
 
         auto IMtag = item->text();
 
+        if(IMtag.compare("PGA") != 0 && IMtag.compare("PGV") != 0)
+        {
+            this->errorMessage("Could not recognize the provided intensity measure "+IMtag);
+            continue;
+        }
+
+        auto IMIndex = gridData.fieldIndex(IMtag);
+
+        if(IMIndex == -1)
+        {
+            this->errorMessage("Error getting the desired IM "+IMtag+" from ShakeMap grid data");
+            return false;
+        }
+
         stationHeader.append(IMtag);
+        IMIndexes.append(IMIndex);
     }
 
     this->statusMessage("Creating ground motion station files from ShakeMap, this may take some time.");
 
     QApplication::processEvents();
 
-    for(int i = 0; i<stationList.size(); ++i)
-    {
-        auto stationFile = "Site_"+QString::number(i)+".csv";
-
-        auto station = stationList.at(i);
-
-        auto lat = QString::number(station.getLatitude());
-        auto lon = QString::number(station.getLongitude());
+    // The stations are saved as an event grid in the legacy layout, a grid file and one station file per station
+    EventGridFile gridFile;
 
-        QStringList stationRow = {stationFile, lat, lon};
+    QString err;
+    if(gridFile.open(pathToEventFile, stationHeader, err) != 0)
+    {
+        this->errorMessage(err);
+        return false;
+    }
 
-        gridData.push_back(stationRow);
+    QStringList IMstrList;
+    IMstrList.reserve(IMIndexes.size());
 
-        QStringList IMstrList;
+    for(int i = 0; i<numPoints; ++i)
+    {
+        IMstrList.clear();
 
-        for(int i = 0; i < IMListWidget->count(); ++i)
+        for(int j = 0; j<IMIndexes.size(); ++j)
         {
-            auto item = IMListWidget->item(i);
+            auto IMVal = gridData.value(i,IMIndexes.at(j));
 
-            if(item->checkState() == Qt::Unchecked)
-                continue;
-
-            auto IMtag = item->text();
-
-            if(IMtag.compare("PGA") == 0)
-            {
-                auto attribVal = station.getAttributeValue(IMtag);
-
-                if(attribVal.isNull())
-                {
-                    this->errorMessage("Error getting the desired IM "+IMtag+" from ShakeMap grid data");
-                    return false;
-                }
+            // Convert PGA from pct g into g, PGV is in units of cmps
+            if(stationHeader.at(j).compare("PGA") == 0)
+                IMVal /= 100.0;
 
-                bool Ok = false;
-                auto PGAval = attribVal.toDouble(&Ok);
-
-                if(!Ok)
-                {
-                    this->errorMessage("Error getting the desired IM "+IMtag+" from ShakeMap grid data");
-                    return false;
-                }
-
-                // Convert from pct g into g
-                PGAval /= 100.0;
-
-                auto PGAstr = QString::number(PGAval);
-                IMstrList.append(PGAstr);
-
-            }
-            else if(IMtag.compare("PGV") == 0)
-            {
-                auto attribVal = station.getAttributeValue(IMtag);
-
-                if(attribVal.isNull())
-                {
-                    this->errorMessage("Error getting the desired IM "+IMtag+" from ShakeMap grid data");
-                    return false;
-                }
-
-                bool Ok = false;
-                auto IMVal = attribVal.toDouble(&Ok);
-
-                if(!Ok)
-                {
-                    this->errorMessage("Error getting the desired IM "+IMtag+" from ShakeMap grid data");
-                    return false;
-                }
-
-                // Units cmps
-                auto IMstr = QString::number(IMVal);
-                IMstrList.append(IMstr);
-            }
-            else
-            {
-                this->errorMessage("Could not recognize the provided intensity measure "+IMtag);
-            }
-        }
-
-        QVector<QStringList> stationData = {stationHeader,IMstrList};
-
-        QString pathToStationFile = motionDir + QDir::separator() + stationFile;
-
-        QString err;
-        auto res2 = csvTool.saveCSVFile(stationData, pathToStationFile, err);
-        if(res2 != 0)
-        {
-            this->errorMessage(err);
-            return false;
+            IMstrList.append(QString::number(IMVal));
         }
 
+        gridFile.addSite(gridData.latitude(i), gridData.longitude(i), IMstrList);
     }
 
-    // Now save the site grid .csv file
-    QString err2;
-    auto res2 = csvTool.saveCSVFile(gridData, pathToEventFile, err2);
-    if(res2 != 0)
+    if(gridFile.close(err) != 0)
     {
-        this->errorMessage(err2);
+        this->errorMessage(err);
         return false;
     }
 #endif
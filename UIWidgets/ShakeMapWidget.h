@@ -39,7 +39,7 @@ UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 // Written by: Stevan Gavrilovic
 
 #include "SimCenterAppWidget.h"
-#include "GroundMotionStation.h"
+#include "XMLAdaptor.h"
 
 #include <QMap>
 
@@ -92,7 +92,7 @@ struct ShakeMap{
         return layers;
     }
 
-    QVector<GroundMotionStation> stationList;
+    ShakeMapGridData gridData;
 };
 
 
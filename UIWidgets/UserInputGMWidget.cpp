@@ -60,6 +60,10 @@ UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 #include <QVBoxLayout>
 #include <QDir>
 #include <QString>
+#include <QThread>
+#include <QtConcurrent>
+
+#include <algorithm>
 
 #include "QGISVisualizationWidget.h"
 
@@ -487,7 +491,7 @@ void UserInputGMWidget::loadUserGMData(void)
     auto stationFilePath = motionDir + QDir::separator() + stationName;
 
     QString err2;
-    QVector<QStringList> sampleStationData = csvTool.parseCSVFile(stationFilePath,err);
+    QVector<QStringList> sampleStationData = csvTool.parseCSVFile(stationFilePath,err2);
 
     // Return if there is an error or the station data is empty
     if(!err2.isEmpty())
@@ -546,8 +550,18 @@ void UserInputGMWidget::loadUserGMData(void)
         lonIndex = 1;
     }
 
-    QgsFeatureList featureList;
-    // Get the data
+    // A station that is imported on the worker threads
+    struct StationImport
+    {
+        QString stationName;
+        std::shared_ptr<GroundMotionStation> station;
+        QString error;
+    };
+
+    QVector<StationImport> stationImports;
+    stationImports.reserve(numRows);
+
+    // Get the locations of the stations from the event grid
     for(int i = 0; i<numRows; ++i)
     {
         auto rowStr = data.at(i);
@@ -582,71 +596,116 @@ void UserInputGMWidget::loadUserGMData(void)
             return;
         }
 
-        GroundMotionStation GMStation(stationPath,lat,lon);
+        StationImport stationImport;
+        stationImport.stationName = stationName;
+        stationImport.station = std::make_shared<GroundMotionStation>(stationPath,lat,lon);
 
+        stationImports.push_back(stationImport);
+    }
+
+    // Parses the station file and the ground motion records of a station, runs on the worker threads
+    auto importStation = [](StationImport& stationImport)
+    {
         try
         {
-            GMStation.importGroundMotions();
+            stationImport.station->importGroundMotions();
         }
         catch(QString msg)
         {
-            auto errorMessage = "Error importing ground motion file: " + stationName+"\n"+msg;
-            this->errorMessage(errorMessage);
+            stationImport.error = msg;
+        }
+        catch(const char* msg)
+        {
+            stationImport.error = QString(msg);
+        }
+    };
 
-            this->hideProgressBar();
+    // The stations are imported a window at a time so that the number of stations in memory, and in flight on the thread pool, stays bounded
+    // The results of each window are merged here in the order of the event grid
+    const int windowSize = 4*QThread::idealThreadCount();
 
-            return;
-        }
+    QgsFeatureList featureList;
+    featureList.reserve(numRows);
 
-        auto stationData = GMStation.getStationData();
+    for(int windowBegin = 0; windowBegin<numRows; windowBegin += windowSize)
+    {
+        auto windowEnd = std::min(windowBegin + windowSize, numRows);
 
-        // create the feature attributes
-        QgsAttributes featAttributes(attribFields.size());
+        auto window = stationImports.mid(windowBegin, windowEnd - windowBegin);
 
-        auto latitude = GMStation.getLatitude();
-        auto longitude = GMStation.getLongitude();
+        QtConcurrent::blockingMap(window, importStation);
 
-        featAttributes[0] = "GroundMotionGridPoint";     // "AssetType"
-        featAttributes[1] = "Ground Motion Grid Point";  // "TabName"
-        featAttributes[2] = stationName;                 // "Station Name"
-        featAttributes[3] = latitude;                    // "Latitude"
-        featAttributes[4] = longitude;                   // "Longitude"
+        for(auto&& stationImport : window)
+        {
+            auto stationName = stationImport.stationName;
 
-        // The number of headings in the file
-        auto numParams = stationData.front().size();
+            if(!stationImport.error.isEmpty())
+            {
+                auto errorMessage = "Error importing ground motion file: " + stationName+"\n"+stationImport.error;
+                this->errorMessage(errorMessage);
 
-        maxToDisp = (maxToDisp<stationData.size() ? maxToDisp : stationData.size());
+                this->hideProgressBar();
 
-        QVector<QString> dataStrs(numParams);
+                return;
+            }
 
-        for(int i = 0; i<maxToDisp-1; ++i)
-        {
-            auto stationParams = stationData[i];
+            const auto& GMStation = *stationImport.station;
 
-            for(int j = 0; j<numParams; ++j)
+            auto stationData = GMStation.getStationData();
+
+            // create the feature attributes
+            QgsAttributes featAttributes(attribFields.size());
+
+            auto latitude = GMStation.getLatitude();
+            auto longitude = GMStation.getLongitude();
+
+            featAttributes[0] = "GroundMotionGridPoint";     // "AssetType"
+            featAttributes[1] = "Ground Motion Grid Point";  // "TabName"
+            featAttributes[2] = stationName;                 // "Station Name"
+            featAttributes[3] = latitude;                    // "Latitude"
+            featAttributes[4] = longitude;                   // "Longitude"
+
+            // The number of headings in the file
+            auto numParams = stationData.front().size();
+
+            maxToDisp = (maxToDisp<stationData.size() ? maxToDisp : stationData.size());
+
+            QVector<QString> dataStrs(numParams);
+
+            for(int i = 0; i<maxToDisp-1; ++i)
             {
-                dataStrs[j] += stationParams[j] + ", ";
+                auto stationParams = stationData[i];
+
+                for(int j = 0; j<numParams; ++j)
+                {
+                    dataStrs[j] += stationParams[j] + ", ";
+                }
             }
-        }
 
-        for(int j = 0; j<numParams; ++j)
-        {
-            auto str = dataStrs[j] ;
-            str += stationData[maxToDisp-1][j];
+            for(int j = 0; j<numParams; ++j)
+            {
+                auto str = dataStrs[j] ;
+                str += stationData[maxToDisp-1][j];
+
+                if(maxToDisp<stationData.size())
+                    str += "...";
+
+                featAttributes[5+j] = str;
+            }
 
-            if(maxToDisp<stationData.size())
-                str += "...";
+            // Create the feature
+            QgsFeature feature;
+            feature.setGeometry(QgsGeometry::fromPointXY(QgsPointXY(longitude,latitude)));
+            feature.setAttributes(featAttributes);
+            featureList.append(feature);
 
-            featAttributes[5+j] = str;
+            ++count;
         }
 
-        // Create the feature
-        QgsFeature feature;
-        feature.setGeometry(QgsGeometry::fromPointXY(QgsPointXY(longitude,latitude)));
-        feature.setAttributes(featAttributes);
-        featureList.append(feature);
+        // Release the imported stations of this window, only the features are kept
+        for(int i = windowBegin; i<windowEnd; ++i)
+            stationImports[i].station.reset();
 
-        ++count;
         progressLabel->clear();
         progressBar->setValue(count);
 
@@ -40,6 +40,7 @@ UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 #include "GoogleAnalytics.h"
 #include "MainWindowWorkflowApp.h"
 #include "WorkflowAppR2D.h"
+#include "AsyncLogSink.h"
 
 #ifdef INCLUDE_USER_PASS
 #include "R2DUserPass.h"
@@ -60,10 +61,14 @@ UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 #include <QTime>
 #include <QWebEngineView>
 
+#include <memory>
+
 #include "qgsapplication.h"
 
 static QString logFilePath;
 static bool logToFile = false;
+// Lives until the static objects are destroyed so that messages from the destructors that run after main() returns still reach the file
+static std::unique_ptr<AsyncLogSink> logSink;
 
 // customMessgaeOutput code taken from web:
 // https://stackoverflow.com/questions/4954140/how-to-redirect-qdebug-qwarning-qcritical-etc-output
@@ -78,13 +83,14 @@ void customMessageOutput(QtMsgType type, const QMessageLogContext &context, cons
     QString logLevelName = msgLevelHash[type];
     QByteArray logLevelMsg = logLevelName.toLocal8Bit();
 
-    if (logToFile) {
+    if (logToFile && logSink != nullptr) {
         QString txt = QString("%1 %2: %3 (%4)").arg(formattedTime, logLevelName, msg,  context.file);
-        QFile outFile(logFilePath);
-        outFile.open(QIODevice::WriteOnly | QIODevice::Append);
-        QTextStream ts(&outFile);
-        ts << txt << "\n";
-        outFile.close();
+
+        // The file is written on a background thread, except for fatal messages that have to reach the file before the abort
+        if (type == QtFatalMsg)
+            logSink->writeSynchronously(txt.toUtf8());
+        else
+            logSink->write(txt.toUtf8());
     } else {
         fprintf(stderr, "%s %s: %s (%s:%u, %s)\n", formattedTimeMsg.constData(), logLevelMsg.constData(), localMsg.constData(), context.file, context.line, context.function);
         fflush(stderr);
@@ -134,7 +140,10 @@ int main(int argc, char *argv[])
     QByteArray envVar = qgetenv("QTDIR");  //  check if the app is run in Qt Creator
 
     if (envVar.isEmpty())
+    {
         logToFile = true;
+        logSink = std::make_unique<AsyncLogSink>(logFilePath);
+    }
 
     qInstallMessageHandler(customMessageOutput);
 
@@ -262,5 +271,13 @@ int main(int argc, char *argv[])
 
     GoogleAnalytics::EndSession();
 
+    // Write out the remaining log messages and stop the writer thread
+    // The default handler is restored so that anything logged after this, e.g., while the application and the static sink are destroyed, goes to stderr and never reaches a destroyed sink
+    if (logSink != nullptr)
+    {
+        logSink->shutdown();
+        qInstallMessageHandler(nullptr);
+    }
+
     return res;
 }